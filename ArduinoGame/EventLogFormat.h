@@ -0,0 +1,83 @@
+
+/* ArduinoGame */
+/* EventLogFormat.h */
+
+//
+// CxgÕt@C`
+// Q[{ (Main.cpp) Ɖ̓c[ (Tools/EventLogDecoder) ̗QƂ
+//
+// t@CEventLogHeadeřEventRecordL^ꂽɕ (gGfBA)
+// R[h̓XbhƂɂ܂Ƃ߂ďo邽, ̏ɂ͕΂Ȃ
+// t@C͈̑傫Ƃɐ؂ւ, Nō쐬ꂽt@C͋L^JnL
+//
+
+#pragma once
+
+#include <cstdint>
+
+//
+// EventLogHeader\
+//
+struct EventLogHeader
+{
+    char mMagic[8];                 // ʎq ("AGEVTLOG")
+    std::uint32_t mVersion;         // `̃o[W
+    std::uint32_t mRecordSize;      // 1R[h̃oCg
+    std::int64_t mStartTime;        // L^Jn (UNIX[s], eR[h̎̌_)
+};
+
+//
+// EventType񋓑
+// eCxg̈̈Ӗ͈ȉ̒ʂ
+//
+enum class EventType : std::uint16_t
+{
+    DroppedRecords = 1,     // 0: Xbhԍ, 1: obt@ĔjR[h
+    StateTransition = 2,    // 0: JڑȌ, 1: Jڌ̏, 2: XRA
+    Score = 3,              // 0: Z̗R (ScoreReason), 1: Z, 2: Z̃XRA
+    ParseFailure = 4,       // 0: s̒, 1: s̐擪8oCg, 2: {[[g
+    SerialError = 5,        // 0: ClearCommError̃G[tO (CE_*), 1: ML[̃oCg
+    SerialIoError = 6,      // 0: GetLastError̒l, 1: s (SerialOperation)
+    ConnectionState = 7,    // 0: ڑ, 1: COM|[gԍ
+    FrameTiming = 8         // 0: ɊԂɍȂǂ, 1: `揈̎[ns], 2: ʐ؂ւ̊Ԋu[ns]
+};
+
+//
+// ScoreReason񋓑
+//
+enum class ScoreReason : std::uint32_t
+{
+    PipePassed = 0,         // yǂʉ߂
+    Collectible = 1         // ACe
+};
+
+//
+// SerialOperation񋓑
+//
+enum class SerialOperation : std::uint32_t
+{
+    Open = 0,
+    ClearCommError = 1,
+    Read = 2,
+    Write = 3,
+    SetCommState = 4
+};
+
+//
+// EventRecord\
+//
+struct EventRecord
+{
+    std::uint64_t mTimestamp;       // L^Jňoߎ[ns]
+    std::uint16_t mType;            // Cxg̎ (EventType)
+    std::uint16_t mThreadIndex;     // L^Xbh̔ԍ
+    std::uint32_t mArg0;            // 0
+    std::int64_t mArg1;             // 1
+    std::int64_t mArg2;             // 2
+};
+
+static_assert(sizeof(EventLogHeader) == 24, "EventLogHeader must be 24 bytes");
+static_assert(sizeof(EventRecord) == 32, "EventRecord must be 32 bytes");
+
+const char EventLogMagic[8] = { 'A', 'G', 'E', 'V', 'T', 'L', 'O', 'G' };   // ʎq
+const std::uint32_t EventLogVersion = 1;                                    // `̃o[W
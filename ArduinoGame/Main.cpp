@@ -3,152 +3,2171 @@
 /* Main.cpp */
 
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <vector>
 
 #define NOMINMAX
 #include "DxLib.h"
 
+#include "EventLogFormat.h"
+
+#pragma comment(lib, "winmm.lib")
+
 template <typename T>
 T Pi = static_cast<T>(3.141592653589793);
 
 template <typename T>
 inline T ConvertDegreeToRadian(T degreeValue)
 {
-    return degreeValue * Pi<T> / static_cast<T>(180.0);
+    return degreeValue * Pi<T> / static_cast<T>(180.0);
+}
+
+template <typename T>
+inline T ConvertRadianToDegree(T radianValue)
+{
+    return radianValue * static_cast<T>(180.0) / Pi<T>;
+}
+
+//
+// CEventBufferNX
+// 1̃Xbh, op̃XbhǂݏobNt[̃Oobt@
+//
+class CEventBuffer
+{
+public:
+    CEventBuffer(std::uint16_t threadIndex);
+
+    CEventBuffer(const CEventBuffer&) = delete;
+    CEventBuffer& operator=(const CEventBuffer&) = delete;
+
+    bool Push(const EventRecord& eventRecord);
+    std::size_t Pop(EventRecord* pEventRecords, std::size_t maxRecords);
+    inline std::uint16_t GetThreadIndex() const { return this->mThreadIndex; }
+    inline std::uint64_t GetNumOfDropped() const { return this->mNumOfDropped.load(std::memory_order_relaxed); }
+
+    static const std::size_t Capacity;              // ێł郌R[h (2̗ݏ)
+
+private:
+    static const std::size_t CacheLineSize = 64;    // LbVC̑傫[oCg]
+
+    // ݑƓǂݏoXV郁o̊Ԃɋlߕ, LbVCɍڂȂ悤ɂ
+    // (C++14łnewalignas̎wۏ؂Ȃ, alignas͗pȂ)
+    std::uint16_t mThreadIndex;                     // ރXbh̔ԍ
+    std::vector<EventRecord> mRecords;              // R[h̔z
+    char mPadding0[CacheLineSize];                  // lߕ
+    std::atomic<std::size_t> mHead;                 // ɏވʒu (ݑ݂̂XV)
+    std::atomic<std::uint64_t> mNumOfDropped;       // ĔjR[h (ݑ݂̂XV)
+    char mPadding1[CacheLineSize];                  // lߕ
+    std::atomic<std::size_t> mTail;                 // ɓǂݏoʒu (ǂݏô݂XV)
+    char mPadding2[CacheLineSize];                  // lߕ
+};
+
+const std::size_t CEventBuffer::Capacity = 8192;        // ێł郌R[h (2̗ݏ)
+const std::size_t CEventBuffer::CacheLineSize;          // LbVC̑傫[oCg] (z̗vf̂߃NXŏ)
+
+CEventBuffer::CEventBuffer(std::uint16_t threadIndex) :
+    mThreadIndex(threadIndex),
+    mRecords(CEventBuffer::Capacity),
+    mPadding0(),
+    mHead(0),
+    mNumOfDropped(0),
+    mPadding1(),
+    mTail(0),
+    mPadding2()
+{
+}
+
+bool CEventBuffer::Push(const EventRecord& eventRecord)
+{
+    std::size_t head = this->mHead.load(std::memory_order_relaxed);
+    std::size_t tail = this->mTail.load(std::memory_order_acquire);
+
+    // oǂtȂꍇ͑҂ɔj
+    if (head - tail >= CEventBuffer::Capacity) {
+        this->mNumOfDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    this->mRecords[head & (CEventBuffer::Capacity - 1)] = eventRecord;
+    this->mHead.store(head + 1, std::memory_order_release);
+
+    return true;
+}
+
+std::size_t CEventBuffer::Pop(EventRecord* pEventRecords, std::size_t maxRecords)
+{
+    std::size_t tail = this->mTail.load(std::memory_order_relaxed);
+    std::size_t head = this->mHead.load(std::memory_order_acquire);
+    std::size_t numOfRecords = std::min(head - tail, maxRecords);
+
+    for (std::size_t i = 0; i < numOfRecords; ++i)
+        pEventRecords[i] = this->mRecords[(tail + i) & (CEventBuffer::Capacity - 1)];
+
+    this->mTail.store(tail + numOfRecords, std::memory_order_release);
+
+    return numOfRecords;
+}
+
+//
+// CEventLogNX
+// Œ蒷̃oCi`ŃCxgL^
+// eXbh͎g̃obt@ɏނ݂̂, t@Cւ̏o͕ʃXbhōs
+// t@C͈̑傫𒴂ƐVt@Cɐ؂ւ, Ât@Č͈cč폜
+//
+class CEventLog final
+{
+public:
+    static CEventLog* GetInstance();
+
+    CEventLog(const CEventLog&) = delete;
+    CEventLog(CEventLog&&) = delete;
+    CEventLog& operator=(const CEventLog&) = delete;
+    CEventLog& operator=(CEventLog&&) = delete;
+
+    bool Start(const char* directoryName);
+    void Stop();
+    void Write(EventType eventType, std::uint32_t arg0, std::int64_t arg1 = 0, std::int64_t arg2 = 0);
+
+private:
+    CEventLog();
+    ~CEventLog();
+
+    CEventBuffer* GetThreadBuffer();
+    void WriterMain();
+    void Flush();
+    bool OpenFile();
+    void DeleteOldFiles() const;
+
+private:
+    static const int MaxThreads = 8;                        // L^łXbh̍ől
+    static const int FlushInterval;                         // t@Cւ̏o̊Ԋu[ms]
+    static const long long MaxFileSize;                     // 1̃t@C̑傫̍ől[oCg]
+    static const std::size_t MaxFiles;                      // ct@Č̍ől
+
+    std::atomic<bool> mIsEnabled;                           // L^ǂ
+    std::chrono::steady_clock::time_point mStartTime;       // L^Jn
+    std::int64_t mStartUnixTime;                            // L^Jn (UNIX[s])
+    std::atomic<CEventBuffer*> mBuffers[MaxThreads];        // XbhƂ̃obt@
+    std::atomic<int> mNumOfBuffers;                         // o^ꂽobt@̐
+
+    std::thread mWriterThread;                              // osXbh
+    std::mutex mMutex;                                      // ~vی삷~[ebNX
+    std::condition_variable mStopCondition;                 // ~v̒ʒm
+    bool mStopRequested;                                    // ~v
+    std::string mDirectoryName;                             // õfBNg
+    std::FILE* mFile;                                       // õt@C
+    long long mFileSize;                                    // õt@C̑傫[oCg]
+    int mFileIndex;                                         // ɍ쐬t@C̒ʂԍ
+    std::vector<EventRecord> mWriteBuffer;                  // op̃obt@
+    std::uint64_t mNumOfReportedDropped[MaxThreads];        // L^ς݂̔jR[h
+};
+
+const int CEventLog::MaxThreads;                            // L^łXbh̍ől (z̗vf̂߃NXŏ)
+const int CEventLog::FlushInterval = 20;                    // t@Cւ̏o̊Ԋu[ms]
+const long long CEventLog::MaxFileSize = 32LL * 1024 * 1024; // 1̃t@C̑傫̍ől[oCg]
+const std::size_t CEventLog::MaxFiles = 16;                 // ct@Č̍ől
+
+CEventLog* CEventLog::GetInstance()
+{
+    static CEventLog theInstance;
+    return &theInstance;
+}
+
+CEventLog::CEventLog() :
+    mIsEnabled(false),
+    mStartTime(),
+    mStartUnixTime(0),
+    mBuffers(),
+    mNumOfBuffers(0),
+    mWriterThread(),
+    mMutex(),
+    mStopCondition(),
+    mStopRequested(false),
+    mDirectoryName(),
+    mFile(nullptr),
+    mFileSize(0),
+    mFileIndex(0),
+    mWriteBuffer(),
+    mNumOfReportedDropped()
+{
+}
+
+CEventLog::~CEventLog()
+{
+    this->Stop();
+
+    for (auto& buffer : this->mBuffers)
+        delete buffer.load();
+}
+
+bool CEventLog::Start(const char* directoryName)
+{
+    if (this->mWriterThread.joinable())
+        return true;
+
+    // õfBNg̍쐬 (ɑ݂ꍇ͂̂܂܎gp)
+    if (!::CreateDirectoryA(directoryName, NULL) && ::GetLastError() != ERROR_ALREADY_EXISTS)
+        return false;
+
+    this->mDirectoryName = directoryName;
+    this->mStartTime = std::chrono::steady_clock::now();
+    this->mStartUnixTime = static_cast<std::int64_t>(std::time(nullptr));
+    this->mFileIndex = 0;
+
+    if (!this->OpenFile())
+        return false;
+
+    this->mWriteBuffer.resize(CEventBuffer::Capacity);
+    this->mStopRequested = false;
+    this->mWriterThread = std::thread(&CEventLog::WriterMain, this);
+    this->mIsEnabled.store(true, std::memory_order_release);
+
+    return true;
+}
+
+void CEventLog::Stop()
+{
+    if (!this->mWriterThread.joinable())
+        return;
+
+    // L^~߂Ă, c̃R[hoďI
+    this->mIsEnabled.store(false, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mStopRequested = true;
+    }
+
+    this->mStopCondition.notify_all();
+    this->mWriterThread.join();
+
+    if (this->mFile != nullptr) {
+        std::fclose(this->mFile);
+        this->mFile = nullptr;
+    }
+}
+
+void CEventLog::Write(EventType eventType, std::uint32_t arg0, std::int64_t arg1, std::int64_t arg2)
+{
+    if (!this->mIsEnabled.load(std::memory_order_acquire))
+        return;
+
+    CEventBuffer* pBuffer = this->GetThreadBuffer();
+
+    if (pBuffer == nullptr)
+        return;
+
+    EventRecord eventRecord;
+    eventRecord.mTimestamp = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - this->mStartTime).count());
+    eventRecord.mType = static_cast<std::uint16_t>(eventType);
+    eventRecord.mThreadIndex = pBuffer->GetThreadIndex();
+    eventRecord.mArg0 = arg0;
+    eventRecord.mArg1 = arg1;
+    eventRecord.mArg2 = arg2;
+
+    pBuffer->Push(eventRecord);
+}
+
+CEventBuffer* CEventLog::GetThreadBuffer()
+{
+    // eXbh̍ŏ̏ݎɃobt@쐬ēo^
+    // o^łȂXbh͈ȍ~݂̏ĽvXVɔj
+    static thread_local CEventBuffer* pThreadBuffer = nullptr;
+    static thread_local bool isBufferUnavailable = false;
+
+    if (pThreadBuffer != nullptr || isBufferUnavailable)
+        return pThreadBuffer;
+
+    // obt@̐ő吔ɒBĂȂΔԍm (ő吔𒴂đ₳Ȃ)
+    int threadIndex = this->mNumOfBuffers.load();
+
+    do {
+        if (threadIndex >= CEventLog::MaxThreads) {
+            isBufferUnavailable = true;
+            return nullptr;
+        }
+    } while (!this->mNumOfBuffers.compare_exchange_weak(threadIndex, threadIndex + 1));
+
+    pThreadBuffer = new CEventBuffer(static_cast<std::uint16_t>(threadIndex));
+    this->mBuffers[threadIndex].store(pThreadBuffer, std::memory_order_release);
+
+    return pThreadBuffer;
+}
+
+void CEventLog::WriterMain()
+{
+    for (;;) {
+        bool isStopRequested;
+
+        {
+            std::unique_lock<std::mutex> lock(this->mMutex);
+            isStopRequested = this->mStopCondition.wait_for(
+                lock, std::chrono::milliseconds(CEventLog::FlushInterval),
+                [this]() { return this->mStopRequested; });
+        }
+
+        this->Flush();
+
+        if (isStopRequested)
+            break;
+    }
+}
+
+void CEventLog::Flush()
+{
+    int numOfBuffers = std::min(this->mNumOfBuffers.load(), CEventLog::MaxThreads);
+
+    for (int i = 0; i < numOfBuffers; ++i) {
+        // o^r̃obt@͎ɏo
+        CEventBuffer* pBuffer = this->mBuffers[i].load(std::memory_order_acquire);
+
+        if (pBuffer == nullptr)
+            continue;
+
+        std::size_t numOfRecords;
+
+        while ((numOfRecords = pBuffer->Pop(
+            this->mWriteBuffer.data(), this->mWriteBuffer.size())) > 0) {
+            // Vt@CJȂꍇ͓ǂݏoĔj
+            if (this->mFile == nullptr)
+                continue;
+
+            std::fwrite(this->mWriteBuffer.data(), sizeof(EventRecord), numOfRecords, this->mFile);
+            this->mFileSize += static_cast<long long>(numOfRecords * sizeof(EventRecord));
+        }
+
+        // obt@ăR[hjĂꍇ͂̐L^
+        std::uint64_t numOfDropped = pBuffer->GetNumOfDropped();
+
+        if (numOfDropped != this->mNumOfReportedDropped[i] && this->mFile != nullptr) {
+            EventRecord eventRecord;
+            eventRecord.mTimestamp = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - this->mStartTime).count());
+            eventRecord.mType = static_cast<std::uint16_t>(EventType::DroppedRecords);
+            eventRecord.mThreadIndex = pBuffer->GetThreadIndex();
+            eventRecord.mArg0 = static_cast<std::uint32_t>(i);
+            eventRecord.mArg1 = static_cast<std::int64_t>(numOfDropped - this->mNumOfReportedDropped[i]);
+            eventRecord.mArg2 = 0;
+            std::fwrite(&eventRecord, sizeof(EventRecord), 1, this->mFile);
+            this->mFileSize += static_cast<long long>(sizeof(EventRecord));
+
+            this->mNumOfReportedDropped[i] = numOfDropped;
+        }
+    }
+
+    if (this->mFile == nullptr)
+        return;
+
+    // ُIĂoς݂̃R[hc悤ɂ
+    std::fflush(this->mFile);
+
+    // 傫̍ől𒴂Vt@Cɐ؂ւ
+    if (this->mFileSize >= CEventLog::MaxFileSize) {
+        std::fclose(this->mFile);
+        this->mFile = nullptr;
+        this->OpenFile();
+    }
+}
+
+bool CEventLog::OpenFile()
+{
+    // Ât@C폜Ă, L^Jnƒʂԍ猈߂Õt@C쐬
+    this->DeleteOldFiles();
+
+    char startTimeText[32];
+    char fileName[64];
+    std::time_t startTime = static_cast<std::time_t>(this->mStartUnixTime);
+    std::tm localTime;
+    ::localtime_s(&localTime, &startTime);
+    std::strftime(startTimeText, sizeof(startTimeText), "%Y%m%d_%H%M%S", &localTime);
+    std::snprintf(fileName, sizeof(fileName), "EventLog_%s_%03d.bin", startTimeText, this->mFileIndex++);
+
+    std::string filePath = this->mDirectoryName + "\\" + fileName;
+
+    if (::fopen_s(&this->mFile, filePath.c_str(), "wb") != 0 || this->mFile == nullptr) {
+        this->mFile = nullptr;
+        return false;
+    }
+
+    // t@C̐擪̏ (L^Jn͐؂ւÕt@CƋ)
+    EventLogHeader eventLogHeader;
+    std::memcpy(eventLogHeader.mMagic, EventLogMagic, sizeof(eventLogHeader.mMagic));
+    eventLogHeader.mVersion = EventLogVersion;
+    eventLogHeader.mRecordSize = static_cast<std::uint32_t>(sizeof(EventRecord));
+    eventLogHeader.mStartTime = this->mStartUnixTime;
+    std::fwrite(&eventLogHeader, sizeof(EventLogHeader), 1, this->mFile);
+    this->mFileSize = static_cast<long long>(sizeof(EventLogHeader));
+
+    return true;
+}
+
+void CEventLog::DeleteOldFiles() const
+{
+    // t@C͍쐬ɕԂ, ȌŌÂ̂폜
+    // ꂩ쐬t@C̕󂯂Ă
+    std::vector<std::string> fileNames;
+    WIN32_FIND_DATAA findData;
+    HANDLE findHandle = ::FindFirstFileA((this->mDirectoryName + "\\EventLog_*.bin").c_str(), &findData);
+
+    if (findHandle == INVALID_HANDLE_VALUE)
+        return;
+
+    do {
+        fileNames.push_back(findData.cFileName);
+    } while (::FindNextFileA(findHandle, &findData));
+
+    ::FindClose(findHandle);
+
+    if (fileNames.size() < CEventLog::MaxFiles)
+        return;
+
+    std::sort(fileNames.begin(), fileNames.end());
+
+    for (std::size_t i = 0; i <= fileNames.size() - CEventLog::MaxFiles; ++i)
+        ::DeleteFileA((this->mDirectoryName + "\\" + fileNames[i]).c_str());
+}
+
+//
+// CArduinoSerialInputNX
+// ȉURLɌfڂĂ\[XR[hςĎgp
+// https://blog.manash.me/serial-communication-with-an-arduino-using-c-on-windows-d08710186498
+//
+class CArduinoSerialInput
+{
+public:
+    CArduinoSerialInput(const char* portName);
+    ~CArduinoSerialInput();
+
+    int Read(char* pBuffer, unsigned int bufferSize);
+    bool Write(const char* pBuffer, unsigned int bufferSize);
+    bool SetBaudRate(DWORD baudRate);
+    inline bool IsConnected() const { return this->mIsConnected; }
+    inline DWORD GetBaudRate() const { return this->mBaudRate; }
+    inline DWORD GetLastErrorCode() const { return this->mLastErrorCode; }
+
+private:
+    HANDLE mHandle;
+    COMSTAT mCommStatus;
+    DWORD mError;
+    DWORD mLastErrorCode;
+    DWORD mBaudRate;
+    bool mIsConnected;
+
+    static const DWORD DefaultBaudRate; // ڑ̃{[[g
+    static const DWORD ReadTimeout;     // ǂݍ݂̃^CAEg[ms]
+    static const DWORD WriteTimeout;    // ݂̃^CAEg[ms]
+};
+
+const DWORD CArduinoSerialInput::DefaultBaudRate = CBR_57600;   // ڑ̃{[[g
+const DWORD CArduinoSerialInput::ReadTimeout = 50;              // ǂݍ݂̃^CAEg[ms]
+const DWORD CArduinoSerialInput::WriteTimeout = 100;            // ݂̃^CAEg[ms]
+
+CArduinoSerialInput::CArduinoSerialInput(const char* portName) :
+    mHandle(INVALID_HANDLE_VALUE),
+    mCommStatus(),
+    mError(0),
+    mLastErrorCode(0),
+    mBaudRate(CArduinoSerialInput::DefaultBaudRate),
+    mIsConnected(false)
+{
+    // VA|[g̐ڑ
+    // ڑɎsꍇ̓G[R[hۑ݂̂, _CAO͕\Ȃ
+    this->mHandle = ::CreateFileA(
+        static_cast<LPCSTR>(portName), GENERIC_READ | GENERIC_WRITE, 0, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (this->mHandle == INVALID_HANDLE_VALUE) {
+        this->mLastErrorCode = ::GetLastError();
+        CEventLog::GetInstance()->Write(
+            EventType::SerialIoError, this->mLastErrorCode,
+            static_cast<std::int64_t>(SerialOperation::Open));
+        return;
+    }
+
+    // VA|[ǧ݂̃p[^̎擾
+    DCB dcbSerialInputParameters;
+    ZeroMemory(&dcbSerialInputParameters, sizeof(DCB));
+
+    if (!::GetCommState(this->mHandle, &dcbSerialInputParameters)) {
+        this->mLastErrorCode = ::GetLastError();
+        return;
+    }
+
+    // VA|[g̃p[^̐ݒ
+    dcbSerialInputParameters.BaudRate = CArduinoSerialInput::DefaultBaudRate;
+    dcbSerialInputParameters.ByteSize = 8;
+    dcbSerialInputParameters.StopBits = ONESTOPBIT;
+    dcbSerialInputParameters.Parity = NOPARITY;
+    dcbSerialInputParameters.fDtrControl = DTR_CONTROL_ENABLE;
+
+    if (!::SetCommState(this->mHandle, &dcbSerialInputParameters)) {
+        this->mLastErrorCode = ::GetLastError();
+        return;
+    }
+
+    // ǂݍ݂Ə݂̃^CAEg̐ݒ
+    // Mς݂̃f[^ΑɕԂ, Ȃ΍őReadTimeout[ms]ҋ@
+    COMMTIMEOUTS commTimeouts;
+    ZeroMemory(&commTimeouts, sizeof(COMMTIMEOUTS));
+    commTimeouts.ReadIntervalTimeout = MAXDWORD;
+    commTimeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+    commTimeouts.ReadTotalTimeoutConstant = CArduinoSerialInput::ReadTimeout;
+    commTimeouts.WriteTotalTimeoutConstant = CArduinoSerialInput::WriteTimeout;
+
+    if (!::SetCommTimeouts(this->mHandle, &commTimeouts)) {
+        this->mLastErrorCode = ::GetLastError();
+        return;
+    }
+
+    // VA|[g̐ڑ̊
+    this->mIsConnected = true;
+    ::PurgeComm(this->mHandle, PURGE_RXCLEAR | PURGE_TXCLEAR);
+}
+
+CArduinoSerialInput::~CArduinoSerialInput()
+{
+    if (this->mHandle != INVALID_HANDLE_VALUE) {
+        ::CloseHandle(this->mHandle);
+        this->mHandle = INVALID_HANDLE_VALUE;
+    }
+
+    this->mIsConnected = false;
+}
+
+int CArduinoSerialInput::Read(char* pBuffer, unsigned int bufferSize)
+{
+    DWORD bytesRead = 0;
+
+    // ʐMG[̊mF ({[hOꂽꍇ͂Ŏs)
+    if (!::ClearCommError(this->mHandle, &this->mError, &this->mCommStatus)) {
+        this->mLastErrorCode = ::GetLastError();
+        this->mIsConnected = false;
+        CEventLog::GetInstance()->Write(
+            EventType::SerialIoError, this->mLastErrorCode,
+            static_cast<std::int64_t>(SerialOperation::ClearCommError));
+        return -1;
+    }
+
+    // I[o[t[~OG[Ȃǂ̒ʐMG[L^
+    if (this->mError != 0)
+        CEventLog::GetInstance()->Write(
+            EventType::SerialError, this->mError, this->mCommStatus.cbInQue);
+
+    // Mς݂̃f[^ǂݍ (Mf[^Ȃ΃^CAEg܂őҋ@)
+    if (!::ReadFile(this->mHandle, pBuffer, bufferSize, &bytesRead, NULL)) {
+        this->mLastErrorCode = ::GetLastError();
+        this->mIsConnected = false;
+        CEventLog::GetInstance()->Write(
+            EventType::SerialIoError, this->mLastErrorCode,
+            static_cast<std::int64_t>(SerialOperation::Read));
+        return -1;
+    }
+
+    return static_cast<int>(bytesRead);
+}
+
+bool CArduinoSerialInput::Write(const char* pBuffer, unsigned int bufferSize)
+{
+    DWORD bytesWritten = 0;
+
+    if (!::WriteFile(this->mHandle, pBuffer, bufferSize, &bytesWritten, NULL)) {
+        this->mLastErrorCode = ::GetLastError();
+        this->mIsConnected = false;
+        CEventLog::GetInstance()->Write(
+            EventType::SerialIoError, this->mLastErrorCode,
+            static_cast<std::int64_t>(SerialOperation::Write));
+        return false;
+    }
+
+    // ^CAEgɂSď߂Ȃꍇ͎sƂ (ؒf͂Ȃ)
+    return bytesWritten == bufferSize;
+}
+
+bool CArduinoSerialInput::SetBaudRate(DWORD baudRate)
+{
+    // VA|[ǧ݂̃p[^̎擾
+    DCB dcbSerialInputParameters;
+    ZeroMemory(&dcbSerialInputParameters, sizeof(DCB));
+
+    if (!::GetCommState(this->mHandle, &dcbSerialInputParameters)) {
+        this->mLastErrorCode = ::GetLastError();
+        return false;
+    }
+
+    // {[[ĝ݂ύX
+    dcbSerialInputParameters.BaudRate = baudRate;
+
+    if (!::SetCommState(this->mHandle, &dcbSerialInputParameters)) {
+        this->mLastErrorCode = ::GetLastError();
+        CEventLog::GetInstance()->Write(
+            EventType::SerialIoError, this->mLastErrorCode,
+            static_cast<std::int64_t>(SerialOperation::SetCommState));
+        return false;
+    }
+
+    // ؂ւÕ{[[gŎMf[^͔j
+    ::PurgeComm(this->mHandle, PURGE_RXCLEAR);
+    this->mBaudRate = baudRate;
+
+    return true;
+}
+
+//
+// ArduinoSample\
+//
+struct ArduinoSample
+{
+    int mValue;                                         // ZT̏o͒l
+    std::chrono::steady_clock::time_point mTimestamp;   // v ({[h̎Ȃꍇ͎M)
+};
+
+//
+// ArduinoDeviceConfig\
+// eo0̏ꍇ̓{[h̐ݒύXȂ
+//
+struct ArduinoDeviceConfig
+{
+    int mSamplingRate;      // TvOg[Hz]
+    int mBatchSize;         // 1ɑMo͒ľ
+    int mBaudRate;          // {[[g[bps]
+};
+
+//
+// ArduinoConnectionState񋓑
+//
+enum class ArduinoConnectionState
+{
+    Searching,
+    Connected,
+    Reconnecting
+};
+
+//
+// ArduinoCommandResult񋓑
+//
+enum class ArduinoCommandResult
+{
+    Acknowledged,
+    Rejected,
+    TimedOut,
+    Disconnected
+};
+
+//
+// CArduinoConnectionNX
+// `XbhƂ͕ʂ̃XbhŃ|[g̒T, ڑ̊mF, Đڑs
+//
+// {[hƂ̒ʐM͉sŋ؂ꂽsPʂōs
+// {[hQ[ւ̑M
+//   <l>,<l>                      ZT̏o͒l (Ň`)
+//   @<n>,<t0>,<dt>,<v1>,...,<vn>   ܂Ƃ߂đMꂽn̏o͒l
+//                                  (t0: ŏ̏o͒ľv[us], dt: vԊu[us])
+//   #ACK <R}h> [<l>]         R}h̎
+//   #NAK <R}h>                R}h̋
+// Q[{[hւ̑M
+//   !PING                          ̊mF
+//   !RATE <Hz>                     TvOg̐ݒ
+//   !BATCH <n>                     1ɑMo͒ľ̐ݒ
+//   !BAUD <bps>                    {[[g̕ύX (ACK̑Mɐ؂ւ,
+//                                  2bȓPINGMȂΌ̃{[[gɖ߂)
+// PINGɉȂ{[h͋Ň`̂܂܎gp
+//
+class CArduinoConnection
+{
+public:
+    CArduinoConnection(const char* preferredPortName, const ArduinoDeviceConfig& deviceConfig);
+    ~CArduinoConnection();
+
+    CArduinoConnection(const CArduinoConnection&) = delete;
+    CArduinoConnection(CArduinoConnection&&) = delete;
+    CArduinoConnection& operator=(const CArduinoConnection&) = delete;
+    CArduinoConnection& operator=(CArduinoConnection&&) = delete;
+
+    void Start();
+    void Stop();
+    void FetchSamples(std::vector<ArduinoSample>& samples);
+    std::string GetPortName();
+    ArduinoDeviceConfig GetAppliedConfig();
+    inline ArduinoConnectionState GetState() const { return this->mState.load(); }
+
+private:
+    void ThreadMain();
+    void EnumeratePorts(std::vector<std::string>& portNames) const;
+    CArduinoSerialInput* ProbePort(const std::string& portName);
+    bool ConfigureDevice(CArduinoSerialInput* pSerialInput);
+    bool ChangeBaudRate(CArduinoSerialInput* pSerialInput, int baudRate);
+    ArduinoCommandResult SendCommand(
+        CArduinoSerialInput* pSerialInput, const char* commandName, int commandValue, int numOfRetries);
+    void ReceiveSamples(CArduinoSerialInput* pSerialInput);
+    int ReceiveLines(CArduinoSerialInput* pSerialInput, std::vector<ArduinoSample>& samples);
+    void PushSamples(std::vector<ArduinoSample>& samples);
+    void ParseAcknowledgement(const std::string& line);
+    bool ParseBatch(
+        const char* pLine, std::chrono::steady_clock::time_point receivedTime,
+        std::vector<ArduinoSample>& samples);
+    void ResetDeviceTime();
+    void SetState(ArduinoConnectionState connectionState);
+    bool WaitForStop(int milliseconds);
+    bool IsStopRequested();
+
+    static bool ParseLine(const char* pLine, int& inputValue);
+
+private:
+    std::thread mThread;                            // ڑsXbh
+    std::mutex mMutex;                              // ȉ̃oی삷~[ebNX
+    std::condition_variable mStopCondition;         // ~v̒ʒm
+    bool mStopRequested;                            // ~v
+    std::string mPortName;                          // ڑ̃|[g
+    std::deque<ArduinoSample> mSamples;             // Mς݂̃ZT̏o͒l
+    ArduinoDeviceConfig mAppliedConfig;             // {[hɓKpꂽݒ
+
+    std::atomic<ArduinoConnectionState> mState;     // ڑ
+    std::string mPreferredPortName;                 // ŏɐڑ݂|[g
+    ArduinoDeviceConfig mDeviceConfig;              // {[hɓKpݒ
+    std::vector<std::string> mBaudRateFailedPortNames;  // {[[g̕ύXɎs|[g
+    char mReceiveBuffer[256];                       // Mobt@
+    std::string mLineBuffer;                        // s܂ł̎Mf[^
+
+    bool mAckReceived;                              // R}h̉Mǂ
+    bool mAckAccepted;                              // R}h󗝂ꂽǂ
+    std::string mAckCommandName;                    // R}h
+
+    bool mHasDeviceTime;                            // {[h̎Mǂ
+    std::uint32_t mLastRawDeviceTime;               // ŌɎM{[h̎[us] (32rbgŏz)
+    long long mDeviceTime;                          // z␳{[h̎[us]
+    std::chrono::steady_clock::time_point mDeviceTimeOrigin;    // {[h̎0ɑΉ鎞
+    std::chrono::steady_clock::time_point mLastBatchTime;       // Ōɂ܂Ƃ߂ĎM
+
+    static const int MaxPortNumber;                 // TCOM|[gԍ̍ől
+    static const int ProbeTimeout;                  // |[g̊mF̃^CAEg[ms]
+    static const int ProbeRequiredLines;            // |[g̊mFɕKvȎMs
+    static const int DataTimeout;                   // Mr₦Ƃ݂Ȃ[ms]
+    static const int MinBackoffTime;                // Đڑ̑ҋ@Ԃ̍ŏl[ms]
+    static const int MaxBackoffTime;                // Đڑ̑ҋ@Ԃ̍ől[ms]
+    static const int CommandTimeout;                // R}h̉̃^CAEg[ms]
+    static const int CommandRetries;                // R}h̍đ
+    static const int BaudRateRevertTime;            // {[h̃{[[gɖ߂܂ł̎[ms]
+    static const int MaxBatchSize = 32;             // 1ɎMo͒ľ̍ől
+    static const double DeviceClockDrift;           // {[h̎̂̋el ()
+    static const std::size_t MaxLineLength;         // 1s̍ő咷
+    static const std::size_t MaxSamples;            // ێMς݂̏o͒l̍ő吔
+};
+
+const int CArduinoConnection::MaxPortNumber = 64;               // TCOM|[gԍ̍ől
+const int CArduinoConnection::ProbeTimeout = 3000;              // |[g̊mF̃^CAEg[ms]
+const int CArduinoConnection::ProbeRequiredLines = 2;           // |[g̊mFɕKvȎMs
+const int CArduinoConnection::DataTimeout = 2000;               // Mr₦Ƃ݂Ȃ[ms]
+const int CArduinoConnection::MinBackoffTime = 250;             // Đڑ̑ҋ@Ԃ̍ŏl[ms]
+const int CArduinoConnection::MaxBackoffTime = 4000;            // Đڑ̑ҋ@Ԃ̍ől[ms]
+const int CArduinoConnection::CommandTimeout = 300;             // R}h̉̃^CAEg[ms]
+const int CArduinoConnection::CommandRetries = 3;               // R}h̍đ
+const int CArduinoConnection::BaudRateRevertTime = 2000;        // {[h̃{[[gɖ߂܂ł̎[ms]
+const double CArduinoConnection::DeviceClockDrift = 0.005;      // {[h̎̂̋el ()
+const std::size_t CArduinoConnection::MaxLineLength = 256;      // 1s̍ő咷
+const std::size_t CArduinoConnection::MaxSamples = 256;         // ێMς݂̏o͒l̍ő吔
+
+CArduinoConnection::CArduinoConnection(
+    const char* preferredPortName, const ArduinoDeviceConfig& deviceConfig) :
+    mThread(),
+    mMutex(),
+    mStopCondition(),
+    mStopRequested(false),
+    mPortName(),
+    mSamples(),
+    mAppliedConfig(),
+    mState(ArduinoConnectionState::Searching),
+    mPreferredPortName(preferredPortName),
+    mDeviceConfig(deviceConfig),
+    mBaudRateFailedPortNames(),
+    mReceiveBuffer(),
+    mLineBuffer(),
+    mAckReceived(false),
+    mAckAccepted(false),
+    mAckCommandName(),
+    mHasDeviceTime(false),
+    mLastRawDeviceTime(0),
+    mDeviceTime(0),
+    mDeviceTimeOrigin(),
+    mLastBatchTime()
+{
+}
+
+CArduinoConnection::~CArduinoConnection()
+{
+    this->Stop();
+}
+
+void CArduinoConnection::Start()
+{
+    if (this->mThread.joinable())
+        return;
+
+    this->mStopRequested = false;
+    this->mState = ArduinoConnectionState::Searching;
+    this->mThread = std::thread(&CArduinoConnection::ThreadMain, this);
+}
+
+void CArduinoConnection::Stop()
+{
+    if (!this->mThread.joinable())
+        return;
+
+    // ~vʒmăXbh̏I҂
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mStopRequested = true;
+    }
+
+    this->mStopCondition.notify_all();
+    this->mThread.join();
+}
+
+void CArduinoConnection::FetchSamples(std::vector<ArduinoSample>& samples)
+{
+    // `XbhĂяo, ǑĂяoȍ~ɎMo͒lo
+    samples.clear();
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    samples.assign(this->mSamples.begin(), this->mSamples.end());
+    this->mSamples.clear();
+}
+
+std::string CArduinoConnection::GetPortName()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mPortName;
+}
+
+ArduinoDeviceConfig CArduinoConnection::GetAppliedConfig()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mAppliedConfig;
+}
+
+void CArduinoConnection::ThreadMain()
+{
+    std::vector<std::string> portNames;
+    int backoffTime = CArduinoConnection::MinBackoffTime;
+
+    while (!this->IsStopRequested()) {
+        // ڑ\ȃ|[g̗
+        this->EnumeratePorts(portNames);
+
+        // ZT̏o͂|[gT
+        CArduinoSerialInput* pSerialInput = nullptr;
+
+        for (const auto& portName : portNames) {
+            if (this->IsStopRequested())
+                break;
+
+            pSerialInput = this->ProbePort(portName);
+
+            if (pSerialInput != nullptr) {
+                std::lock_guard<std::mutex> lock(this->mMutex);
+                this->mPortName = portName;
+                break;
+            }
+        }
+
+        if (pSerialInput != nullptr) {
+            // ڑr₦܂ŃZT̏o͒lM
+            // ͓|[gڑ݂
+            this->mPreferredPortName = this->GetPortName();
+            this->SetState(ArduinoConnectionState::Connected);
+
+            // {[h̐ݒKpĂM𑱂 ({[h͐ڑ̂тɃZbg)
+            // ݒ̓KpɎsꍇ͑ҋ@Ԃɖ߂Ȃ
+            if (this->ConfigureDevice(pSerialInput)) {
+                backoffTime = CArduinoConnection::MinBackoffTime;
+                this->ReceiveSamples(pSerialInput);
+            }
+
+            delete pSerialInput;
+
+            {
+                std::lock_guard<std::mutex> lock(this->mMutex);
+                this->mAppliedConfig = ArduinoDeviceConfig();
+            }
+
+            this->SetState(ArduinoConnectionState::Reconnecting);
+        }
+
+        // 莞ԑҋ@ĂēxT (ҋ@Ԃ͎s邽тɔ{)
+        if (this->WaitForStop(backoffTime))
+            break;
+
+        backoffTime = std::min(backoffTime * 2, CArduinoConnection::MaxBackoffTime);
+    }
+}
+
+void CArduinoConnection::EnumeratePorts(std::vector<std::string>& portNames) const
+{
+    portNames.clear();
+
+    // Oڑ|[g (܂͊̃|[g) ŏɎ
+    portNames.push_back(this->mPreferredPortName);
+
+    // ݂COM|[g
+    char targetPath[256];
+
+    for (int i = 1; i <= CArduinoConnection::MaxPortNumber; ++i) {
+        std::string deviceName = "COM" + std::to_string(i);
+
+        if (::QueryDosDeviceA(deviceName.c_str(), targetPath, sizeof(targetPath)) == 0)
+            continue;
+
+        std::string portName = "\\\\.\\" + deviceName;
+
+        if (portName != this->mPreferredPortName)
+            portNames.push_back(portName);
+    }
+}
+
+CArduinoSerialInput* CArduinoConnection::ProbePort(const std::string& portName)
+{
+    // VA|[g̐ڑ
+    CArduinoSerialInput* pSerialInput = new CArduinoSerialInput(portName.c_str());
+
+    if (!pSerialInput->IsConnected()) {
+        delete pSerialInput;
+        return nullptr;
+    }
+
+    // ZT̏o͌`̍sMł邩ǂmF
+    // |[gJƃ{[hZbg邽, N҂Ԃ܂߂ă^CAEgݒ
+    std::vector<ArduinoSample> samples;
+    auto startTime = std::chrono::steady_clock::now();
+    auto probeTimeout = std::chrono::milliseconds(CArduinoConnection::ProbeTimeout);
+
+    this->mLineBuffer.clear();
+    this->ResetDeviceTime();
+
+    while (!this->IsStopRequested() &&
+           std::chrono::steady_clock::now() - startTime < probeTimeout) {
+        if (this->ReceiveLines(pSerialInput, samples) < 0)
+            break;
+
+        if (samples.size() >= static_cast<std::size_t>(CArduinoConnection::ProbeRequiredLines))
+            return pSerialInput;
+    }
+
+    delete pSerialInput;
+    return nullptr;
+}
+
+bool CArduinoConnection::ConfigureDevice(CArduinoSerialInput* pSerialInput)
+{
+    ArduinoDeviceConfig appliedConfig = ArduinoDeviceConfig();
+    ArduinoCommandResult result;
+
+    // R}hɉ{[hǂmF
+    result = this->SendCommand(pSerialInput, "PING", -1, CArduinoConnection::CommandRetries);
+
+    if (result == ArduinoCommandResult::Disconnected)
+        return false;
+
+    // Ȃ{[h͋N̐ݒ̂܂܎gp
+    if (result != ArduinoCommandResult::Acknowledged)
+        return true;
+
+    // {[[g̕ύX (ȑOɎs|[gł͕ύXȂ)
+    std::string portName = this->GetPortName();
+    bool isBaudRateFailed = std::find(
+        this->mBaudRateFailedPortNames.begin(), this->mBaudRateFailedPortNames.end(),
+        portName) != this->mBaudRateFailedPortNames.end();
+
+    if (this->mDeviceConfig.mBaudRate > 0 && !isBaudRateFailed) {
+        bool isChanged = this->ChangeBaudRate(pSerialInput, this->mDeviceConfig.mBaudRate);
+
+        if (pSerialInput->GetBaudRate() == static_cast<DWORD>(this->mDeviceConfig.mBaudRate))
+            appliedConfig.mBaudRate = this->mDeviceConfig.mBaudRate;
+        else if (pSerialInput->IsConnected())
+            this->mBaudRateFailedPortNames.push_back(portName);
+
+        if (!isChanged)
+            return false;
+    }
+
+    // TvOg̐ݒ
+    if (this->mDeviceConfig.mSamplingRate > 0) {
+        result = this->SendCommand(
+            pSerialInput, "RATE", this->mDeviceConfig.mSamplingRate,
+            CArduinoConnection::CommandRetries);
+
+        if (result == ArduinoCommandResult::Disconnected)
+            return false;
+
+        if (result == ArduinoCommandResult::Acknowledged)
+            appliedConfig.mSamplingRate = this->mDeviceConfig.mSamplingRate;
+    }
+
+    // 1ɑMo͒ľ̐ݒ
+    if (this->mDeviceConfig.mBatchSize > 0) {
+        result = this->SendCommand(
+            pSerialInput, "BATCH", this->mDeviceConfig.mBatchSize,
+            CArduinoConnection::CommandRetries);
+
+        if (result == ArduinoCommandResult::Disconnected)
+            return false;
+
+        if (result == ArduinoCommandResult::Acknowledged)
+            appliedConfig.mBatchSize = this->mDeviceConfig.mBatchSize;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    this->mAppliedConfig = appliedConfig;
+
+    return true;
+}
+
+bool CArduinoConnection::ChangeBaudRate(CArduinoSerialInput* pSerialInput, int baudRate)
+{
+    DWORD oldBaudRate = pSerialInput->GetBaudRate();
+    ArduinoCommandResult result;
+
+    if (static_cast<DWORD>(baudRate) == oldBaudRate)
+        return true;
+
+    // {[hɃ{[[g̕ύXv ({[hACK𑗐MĂ؂ւ)
+    result = this->SendCommand(pSerialInput, "BAUD", baudRate, CArduinoConnection::CommandRetries);
+
+    if (result == ArduinoCommandResult::Disconnected)
+        return false;
+
+    if (result != ArduinoCommandResult::Acknowledged)
+        return true;
+
+    // ؂ւ, V{[[gŒʐMł邩ǂmF
+    if (pSerialInput->SetBaudRate(static_cast<DWORD>(baudRate))) {
+        this->mLineBuffer.clear();
+        this->ResetDeviceTime();
+
+        result = this->SendCommand(pSerialInput, "PING", -1, CArduinoConnection::CommandRetries);
+
+        if (result == ArduinoCommandResult::Disconnected)
+            return false;
+
+        if (result == ArduinoCommandResult::Acknowledged)
+            return true;
+    }
+
+    // ʐMłȂΌ̃{[[gɖ߂
+    // {[hPINGMłȂΈ莞ԌɌ̃{[[gɖ߂̂, ܂ŊmF𑱂
+    if (!pSerialInput->SetBaudRate(oldBaudRate))
+        return false;
+
+    this->mLineBuffer.clear();
+    this->ResetDeviceTime();
+
+    int numOfRetries = CArduinoConnection::BaudRateRevertTime / CArduinoConnection::CommandTimeout +
+        CArduinoConnection::CommandRetries;
+    result = this->SendCommand(pSerialInput, "PING", -1, numOfRetries);
+
+    return result == ArduinoCommandResult::Acknowledged;
+}
+
+ArduinoCommandResult CArduinoConnection::SendCommand(
+    CArduinoSerialInput* pSerialInput, const char* commandName, int commandValue, int numOfRetries)
+{
+    // MR}h̍쐬 (l̏ꍇ͒ltȂ)
+    std::string command = std::string("!") + commandName;
+
+    if (commandValue >= 0)
+        command += " " + std::to_string(commandValue);
+
+    command += "\n";
+
+    std::vector<ArduinoSample> samples;
+    auto commandTimeout = std::chrono::milliseconds(CArduinoConnection::CommandTimeout);
+
+    for (int i = 0; i <= numOfRetries; ++i) {
+        // ~vΐؒfꂽ̂ƂĈ
+        if (this->IsStopRequested())
+            return ArduinoCommandResult::Disconnected;
+
+        this->mAckReceived = false;
+
+        if (!pSerialInput->Write(command.c_str(), static_cast<unsigned int>(command.size()))) {
+            if (!pSerialInput->IsConnected())
+                return ArduinoCommandResult::Disconnected;
+
+            continue;
+        }
+
+        // ҂ԂɎMo͒l`Xbh֓n
+        auto sentTime = std::chrono::steady_clock::now();
+
+        while (std::chrono::steady_clock::now() - sentTime < commandTimeout) {
+            if (this->ReceiveLines(pSerialInput, samples) < 0)
+                return ArduinoCommandResult::Disconnected;
+
+            this->PushSamples(samples);
+
+            if (this->mAckReceived && this->mAckCommandName == commandName)
+                return this->mAckAccepted ?
+                    ArduinoCommandResult::Acknowledged : ArduinoCommandResult::Rejected;
+        }
+    }
+
+    return ArduinoCommandResult::TimedOut;
+}
+
+void CArduinoConnection::ReceiveSamples(CArduinoSerialInput* pSerialInput)
+{
+    std::vector<ArduinoSample> samples;
+    auto lastReceivedTime = std::chrono::steady_clock::now();
+    auto dataTimeout = std::chrono::milliseconds(CArduinoConnection::DataTimeout);
+
+    while (!this->IsStopRequested()) {
+        samples.clear();
+
+        // ǂݍ݂Ɏs{[hOꂽƂ݂Ȃ
+        int numOfSamples = this->ReceiveLines(pSerialInput, samples);
+
+        if (numOfSamples < 0)
+            return;
+
+        auto currentTime = std::chrono::steady_clock::now();
+
+        // 莞ԃZT̏o͒lMłȂ΍Đڑ
+        if (numOfSamples == 0) {
+            if (currentTime - lastReceivedTime > dataTimeout)
+                return;
+
+            continue;
+        }
+
+        lastReceivedTime = currentTime;
+        this->PushSamples(samples);
+    }
+}
+
+void CArduinoConnection::PushSamples(std::vector<ArduinoSample>& samples)
+{
+    if (samples.empty())
+        return;
+
+    // Mo͒lǉ (`XbhoȂꍇ͌Â̂j)
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mSamples.insert(this->mSamples.end(), samples.begin(), samples.end());
+
+        while (this->mSamples.size() > CArduinoConnection::MaxSamples)
+            this->mSamples.pop_front();
+    }
+
+    samples.clear();
+}
+
+int CArduinoConnection::ReceiveLines(
+    CArduinoSerialInput* pSerialInput, std::vector<ArduinoSample>& samples)
+{
+    int bytesRead = pSerialInput->Read(this->mReceiveBuffer, sizeof(this->mReceiveBuffer));
+
+    if (bytesRead < 0)
+        return -1;
+
+    int numOfSamples = 0;
+    auto currentTime = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < bytesRead; ++i) {
+        char receivedChar = this->mReceiveBuffer[i];
+
+        if (receivedChar != '\n') {
+            // sȂ܂ܒȂꍇ͕ʂ̋@Ƃ݂ȂĔj
+            if (this->mLineBuffer.size() < CArduinoConnection::MaxLineLength)
+                this->mLineBuffer.push_back(receivedChar);
+            continue;
+        }
+
+        // sR[ho1sǂݍ
+        if (!this->mLineBuffer.empty() && this->mLineBuffer.back() == '\r')
+            this->mLineBuffer.pop_back();
+
+        if (this->mLineBuffer.empty() ||
+            this->mLineBuffer.size() >= CArduinoConnection::MaxLineLength) {
+            this->mLineBuffer.clear();
+            continue;
+        }
+
+        std::size_t numOfSamplesBefore = samples.size();
+        bool isParsed;
+        int inputValue;
+
+        if (this->mLineBuffer[0] == '#') {
+            // R}h̉
+            this->ParseAcknowledgement(this->mLineBuffer);
+            isParsed = true;
+        } else if (this->mLineBuffer[0] == '@') {
+            // ܂Ƃ߂đMꂽo͒l
+            isParsed = this->ParseBatch(this->mLineBuffer.c_str(), currentTime, samples);
+        } else {
+            // Ň`̏o͒l
+            isParsed = CArduinoConnection::ParseLine(this->mLineBuffer.c_str(), inputValue);
+
+            if (isParsed)
+                samples.push_back(ArduinoSample { inputValue, currentTime });
+        }
+
+        // ǂݍ߂Ȃs͐擪8oCgL^
+        if (!isParsed) {
+            std::int64_t linePrefix = 0;
+            std::memcpy(&linePrefix, this->mLineBuffer.data(),
+                        std::min(this->mLineBuffer.size(), sizeof(linePrefix)));
+            CEventLog::GetInstance()->Write(
+                EventType::ParseFailure, static_cast<std::uint32_t>(this->mLineBuffer.size()),
+                linePrefix, pSerialInput->GetBaudRate());
+        }
+
+        numOfSamples += static_cast<int>(samples.size() - numOfSamplesBefore);
+        this->mLineBuffer.clear();
+    }
+
+    return numOfSamples;
+}
+
+void CArduinoConnection::ParseAcknowledgement(const std::string& line)
+{
+    // "#ACK <R}h> [<l>]" ܂ "#NAK <R}h>" ̓ǂݍ
+    bool isAccepted;
+
+    if (line.compare(0, 5, "#ACK ") == 0)
+        isAccepted = true;
+    else if (line.compare(0, 5, "#NAK ") == 0)
+        isAccepted = false;
+    else
+        return;
+
+    std::size_t nameEnd = line.find(' ', 5);
+
+    this->mAckCommandName = (nameEnd == std::string::npos) ?
+        line.substr(5) : line.substr(5, nameEnd - 5);
+    this->mAckAccepted = isAccepted;
+    this->mAckReceived = true;
+}
+
+bool CArduinoConnection::ParseBatch(
+    const char* pLine, std::chrono::steady_clock::time_point receivedTime,
+    std::vector<ArduinoSample>& samples)
+{
+    // "@<n>,<t0>,<dt>,<v1>,...,<vn>" ̓ǂݍ
+    char* pEnd = nullptr;
+    long numOfValues = std::strtol(pLine + 1, &pEnd, 10);
+
+    if (*pEnd != ',' || numOfValues < 1 || numOfValues > CArduinoConnection::MaxBatchSize)
+        return false;
+
+    std::uint32_t firstRawTime = static_cast<std::uint32_t>(std::strtoul(pEnd + 1, &pEnd, 10));
+
+    if (*pEnd != ',')
+        return false;
+
+    std::uint32_t interval = static_cast<std::uint32_t>(std::strtoul(pEnd + 1, &pEnd, 10));
+    int values[CArduinoConnection::MaxBatchSize];
+
+    for (long i = 0; i < numOfValues; ++i) {
+        if (*pEnd != ',')
+            return false;
+
+        values[i] = static_cast<int>(std::strtol(pEnd + 1, &pEnd, 10));
+    }
+
+    if (*pEnd != '\0')
+        return false;
+
+    // Ō̏o͒ľv (32rbgŏz邽ߑOƂ̍ώZ)
+    std::uint32_t lastRawTime =
+        firstRawTime + interval * static_cast<std::uint32_t>(numOfValues - 1);
+
+    if (this->mHasDeviceTime)
+        this->mDeviceTime += static_cast<std::int32_t>(lastRawTime - this->mLastRawDeviceTime);
+    else
+        this->mDeviceTime = lastRawTime;
+
+    // Mƃ{[h̎̍ł̂, `x̏ȂƂ
+    // {[h̎v̂z邽, ͌oߎԂɉďx点
+    auto candidateOrigin = receivedTime - std::chrono::microseconds(this->mDeviceTime);
+
+    if (this->mHasDeviceTime) {
+        auto driftedOrigin = this->mDeviceTimeOrigin +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                (receivedTime - this->mLastBatchTime) * CArduinoConnection::DeviceClockDrift);
+        this->mDeviceTimeOrigin = std::min(candidateOrigin, driftedOrigin);
+    } else {
+        this->mDeviceTimeOrigin = candidateOrigin;
+    }
+
+    this->mHasDeviceTime = true;
+    this->mLastRawDeviceTime = lastRawTime;
+    this->mLastBatchTime = receivedTime;
+
+    // eo͒ľv̎ɊZ
+    for (long i = 0; i < numOfValues; ++i) {
+        long long sampleTime = this->mDeviceTime -
+            static_cast<long long>(interval) * (numOfValues - 1 - i);
+        samples.push_back(ArduinoSample {
+            values[i], this->mDeviceTimeOrigin + std::chrono::microseconds(sampleTime) });
+    }
+
+    return true;
+}
+
+void CArduinoConnection::ResetDeviceTime()
+{
+    this->mHasDeviceTime = false;
+}
+
+void CArduinoConnection::SetState(ArduinoConnectionState connectionState)
+{
+    this->mState = connectionState;
+
+    // ڑԂ̕ωCOM|[gԍƂƂɋL^
+    std::string portName = this->GetPortName();
+    std::size_t numberPosition = portName.find("COM");
+    int portNumber = (numberPosition != std::string::npos) ?
+        std::atoi(portName.c_str() + numberPosition + 3) : 0;
+
+    CEventLog::GetInstance()->Write(
+        EventType::ConnectionState, static_cast<std::uint32_t>(connectionState), portNumber);
+}
+
+bool CArduinoConnection::WaitForStop(int milliseconds)
+{
+    std::unique_lock<std::mutex> lock(this->mMutex);
+    return this->mStopCondition.wait_for(
+        lock, std::chrono::milliseconds(milliseconds),
+        [this]() { return this->mStopRequested; });
+}
+
+bool CArduinoConnection::IsStopRequested()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mStopRequested;
+}
+
+bool CArduinoConnection::ParseLine(const char* pLine, int& inputValue)
+{
+    // ZT̏o͒l̓ǂݍ
+    int inputValueDummy;
+
+    return sscanf_s(pLine, "%d,%d", &inputValue, &inputValueDummy) == 2;
+}
+
+//
+// CInputPredictorNX
+// ZT̏o͒lƂ̕ωxԂɊÂĕ (dw), ʂɕ\鎞̏o͒lO}
+// eo͒l̏d݂͑Ȍo͒ľoߎԂŌ܂邽, 萔͎Mt[̊ԊuɂȂ
+//
+class CInputPredictor
+{
+public:
+    CInputPredictor();
+
+    void AddSample(const ArduinoSample& sample);
+    void Reset(double value);
+    bool Predict(std::chrono::steady_clock::time_point targetTime, double& predictedValue) const;
+
+private:
+    static const double LevelTimeConstant;          // o͒l̎̕萔[ms]
+    static const double TrendTimeConstant;          // ωx̎̕萔[ms]
+    static const double MinSampleInterval;          // ωx̍XVɕKvȏo͒l̎̊Ԋu[ms]
+    static const double MaxSampleAge;               // O}sŐV̏o͒ľoߎԂ̍ől[ms]
+    static const double MaxHorizon;                 // O}鎞Ԃ̍ől[ms]
+
+    bool mHasSample;                                // o͒lMǂ
+    std::chrono::steady_clock::time_point mLatestTimestamp;     // ŐV̏o͒l̎
+    double mLevel;                                  // o͒l
+    double mTrend;                                  // ωx[1/ms]
+};
+
+const double CInputPredictor::LevelTimeConstant = 100.0;    // o͒l̎̕萔[ms]
+const double CInputPredictor::TrendTimeConstant = 200.0;    // ωx̎̕萔[ms]
+const double CInputPredictor::MinSampleInterval = 1.0;      // ωx̍XVɕKvȏo͒l̎̊Ԋu[ms]
+const double CInputPredictor::MaxSampleAge = 60.0;          // O}sŐV̏o͒ľoߎԂ̍ől[ms]
+const double CInputPredictor::MaxHorizon = 24.0;            // O}鎞Ԃ̍ől[ms]
+
+CInputPredictor::CInputPredictor() :
+    mHasSample(false),
+    mLatestTimestamp(),
+    mLevel(0.0),
+    mTrend(0.0)
+{
+}
+
+void CInputPredictor::AddSample(const ArduinoSample& sample)
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    double sampleValue = static_cast<double>(sample.mValue);
+
+    if (!this->mHasSample) {
+        this->mHasSample = true;
+        this->mLatestTimestamp = sample.mTimestamp;
+        this->mLevel = sampleValue;
+        this->mTrend = 0.0;
+        return;
+    }
+
+    double interval = Milliseconds(sample.mTimestamp - this->mLatestTimestamp).count();
+
+    // ɎMo͒l (܂Ƃ߂ēǂݍ񂾋Ň`̍s) ͏o͒l݂̂𕽊
+    if (interval < CInputPredictor::MinSampleInterval) {
+        double levelWeight = 1.0 - std::exp(
+            -CInputPredictor::MinSampleInterval / CInputPredictor::LevelTimeConstant);
+        this->mLevel += levelWeight * (sampleValue - this->mLevel);
+        return;
+    }
+
+    // oߎԂɉd݂, ωx\lƎMl
+    double levelWeight = 1.0 - std::exp(-interval / CInputPredictor::LevelTimeConstant);
+    double trendWeight = 1.0 - std::exp(-interval / CInputPredictor::TrendTimeConstant);
+    double predictedLevel = this->mLevel + this->mTrend * interval;
+    double level = predictedLevel + levelWeight * (sampleValue - predictedLevel);
+
+    this->mTrend += trendWeight * ((level - this->mLevel) / interval - this->mTrend);
+    this->mLevel = level;
+    this->mLatestTimestamp = sample.mTimestamp;
+}
+
+void CInputPredictor::Reset(double value)
+{
+    // o͒lw肵lɖ߂ (ȍ~̏o͒l͎萔ɏ]ĒǏ])
+    this->mLevel = value;
+    this->mTrend = 0.0;
+}
+
+bool CInputPredictor::Predict(
+    std::chrono::steady_clock::time_point targetTime, double& predictedValue) const
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    if (!this->mHasSample)
+        return false;
+
+    predictedValue = this->mLevel;
+
+    // O}鎞Ԃ͒Z͈͂ɐ (Mr₦Ăꍇ͊O}Ȃ)
+    double horizon = Milliseconds(targetTime - this->mLatestTimestamp).count();
+
+    if (horizon <= 0.0 || horizon > CInputPredictor::MaxSampleAge)
+        return true;
+
+    predictedValue += this->mTrend * std::min(horizon, CInputPredictor::MaxHorizon);
+    return true;
+}
+
+//
+// CFramePacerNX
+// `揈ɂ鎞Ԃv, ͂̎擾`܂ł̐̒O܂Œx点
+//
+class CFramePacer
+{
+public:
+    CFramePacer(int refreshRate);
+
+    void SetRefreshRate(int refreshRate);
+    void WaitForLatch();
+    void EndWork();
+    void EndFrame();
+    inline std::chrono::steady_clock::time_point GetPresentTime() const { return this->mPresentTime; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    void WaitUntil(Clock::time_point wakeUpTime) const;
+    void StartCalibration();
+    double GetMedianInterval() const;
+
+    static inline Clock::duration ToDuration(double milliseconds)
+    {
+        return std::chrono::duration_cast<Clock::duration>(Milliseconds(milliseconds));
+    }
+
+private:
+    static const int WorkTimeHistorySize = 30;      // `揈̎Ԃێt[
+    static const int IntervalHistorySize = 30;      // ʐ؂ւ̊Ԋuێt[
+    static const double FramePeriodTolerance;       // ̊Ԋu̐l̂̋e͈ ()
+    static const double MinSafetyMargin;            // \ɉ]T̍ŏl[ms]
+    static const double MaxSafetyMargin;            // \ɉ]T̍ől[ms]
+    static const double SafetyMarginIncrease;       // ɊԂɍȂꍇ̗]T̑[ms]
+    static const double SafetyMarginDecrease;       // Ԃɍꍇ̗]Ť[ms]
+    static const double SpinThreshold;              // Sleepg킸ɑҋ@c莞[ms]
+
+    double mNominalFramePeriod;                     // ̊Ԋu̐l[ms] (ʐ؂ւ̊Ԋu̒l)
+    double mFramePeriod;                            // ̊Ԋu̎l[ms] (l̋߂ŕ)
+    double mWorkTimes[WorkTimeHistorySize];         // ߂̕`揈̎[ms]
+    int mWorkTimeIndex;                             // ɕ`揈̎Ԃi[CfbNX
+    double mIntervals[IntervalHistorySize];         // ߂̉ʐ؂ւ̊Ԋu[ms]
+    int mIntervalIndex;                             // ɉʐ؂ւ̊Ԋui[CfbNX
+    int mNumOfIntervals;                            // ێĂʐ؂ւ̊Ԋǔ
+    bool mIsCalibrating;                            // ҋ@ɐ̊Ԋu𑪒肵Ă邩ǂ
+    double mSafetyMargin;                           // \ɉ]T[ms]
+    bool mHasLastFlipTime;                          // Ỏʐ؂ւ̎Lǂ
+    Clock::time_point mLastFlipTime;                // Ỏʐ؂ւ̎
+    Clock::time_point mLatchTime;                   // ͂擾
+    Clock::time_point mPresentTime;                 // ʂɕ\鎞̗\l
+};
+
+const int CFramePacer::WorkTimeHistorySize;             // `揈̎Ԃێt[ (z̗vf̂߃NXŏ)
+const int CFramePacer::IntervalHistorySize;             // ʐ؂ւ̊Ԋuێt[ ()
+const double CFramePacer::FramePeriodTolerance = 0.1;   // ̊Ԋu̐l̂̋e͈ ()
+const double CFramePacer::MinSafetyMargin = 1.5;        // \ɉ]T̍ŏl[ms]
+const double CFramePacer::MaxSafetyMargin = 8.0;        // \ɉ]T̍ől[ms]
+const double CFramePacer::SafetyMarginIncrease = 1.0;   // ɊԂɍȂꍇ̗]T̑[ms]
+const double CFramePacer::SafetyMarginDecrease = 0.01;  // Ԃɍꍇ̗]Ť[ms]
+const double CFramePacer::SpinThreshold = 2.0;          // Sleepg킸ɑҋ@c莞[ms]
+
+CFramePacer::CFramePacer(int refreshRate) :
+    mNominalFramePeriod(1000.0 / static_cast<double>(refreshRate)),
+    mFramePeriod(1000.0 / static_cast<double>(refreshRate)),
+    mWorkTimes(),
+    mWorkTimeIndex(0),
+    mIntervals(),
+    mIntervalIndex(0),
+    mNumOfIntervals(0),
+    mIsCalibrating(true),
+    mSafetyMargin(CFramePacer::MinSafetyMargin),
+    mHasLastFlipTime(false),
+    mLastFlipTime(),
+    mLatchTime(),
+    mPresentTime()
+{
+}
+
+void CFramePacer::SetRefreshRate(int refreshRate)
+{
+    // j^̃tbV[g𐄒l̏lƂ, ۂ̊Ԋu𑪒肵
+    if (refreshRate > 0) {
+        this->mNominalFramePeriod = 1000.0 / static_cast<double>(refreshRate);
+        this->mFramePeriod = this->mNominalFramePeriod;
+    }
+
+    this->StartCalibration();
+}
+
+void CFramePacer::WaitForLatch()
+{
+    Clock::time_point currentTime = Clock::now();
+
+    // ̊Ԋȗ蒆͑ҋ@Ȃ
+    if (!this->mHasLastFlipTime || this->mIsCalibrating) {
+        this->mLatchTime = currentTime;
+        this->mPresentTime = currentTime + CFramePacer::ToDuration(this->mFramePeriod);
+        return;
+    }
+
+    // ̐̎\
+    Clock::time_point vsyncTime = this->mLastFlipTime + CFramePacer::ToDuration(this->mFramePeriod);
+
+    // ߂̕`揈̎Ԃ̍őlɗ]TOɓ͂擾
+    double workTime = *std::max_element(
+        std::begin(this->mWorkTimes), std::end(this->mWorkTimes));
+    double leadTime = std::min(workTime + this->mSafetyMargin, this->mFramePeriod);
+
+    this->WaitUntil(vsyncTime - CFramePacer::ToDuration(leadTime));
+
+    this->mLatchTime = Clock::now();
+    this->mPresentTime = vsyncTime;
+}
+
+void CFramePacer::EndWork()
+{
+    // ͂̎擾ʐ؂ւ̒O܂ł̎ԂL^
+    this->mWorkTimes[this->mWorkTimeIndex] =
+        Milliseconds(Clock::now() - this->mLatchTime).count();
+    this->mWorkTimeIndex = (this->mWorkTimeIndex + 1) % CFramePacer::WorkTimeHistorySize;
+}
+
+void CFramePacer::EndFrame()
+{
+    // ʐ؂ւ̊𐂒̎Ƃ݂Ȃ
+    Clock::time_point flipTime = Clock::now();
+
+    if (this->mHasLastFlipTime) {
+        double interval = Milliseconds(flipTime - this->mLastFlipTime).count();
+        bool isMissed = !this->mIsCalibrating && interval > this->mFramePeriod * 1.5;
+
+        // `揈̎ԂƉʐ؂ւ̊ԊuL^
+        int lastWorkTimeIndex = (this->mWorkTimeIndex + CFramePacer::WorkTimeHistorySize - 1) %
+            CFramePacer::WorkTimeHistorySize;
+        CEventLog::GetInstance()->Write(
+            EventType::FrameTiming, isMissed ? 1 : 0,
+            static_cast<std::int64_t>(this->mWorkTimes[lastWorkTimeIndex] * 1000000.0),
+            static_cast<std::int64_t>(interval * 1000000.0));
+
+        this->mIntervals[this->mIntervalIndex] = interval;
+        this->mIntervalIndex = (this->mIntervalIndex + 1) % CFramePacer::IntervalHistorySize;
+        this->mNumOfIntervals = std::min(this->mNumOfIntervals + 1, CFramePacer::IntervalHistorySize);
+
+        if (this->mIsCalibrating) {
+            // ҋ@ɉʂ؂ւԊu̒l𐂒̊ԊuƂ
+            // (EBhE[hł̓j^̃tbV[gŉʂ؂ւ)
+            if (this->mNumOfIntervals == CFramePacer::IntervalHistorySize) {
+                this->mNominalFramePeriod = this->GetMedianInterval();
+                this->mFramePeriod = this->mNominalFramePeriod;
+                this->mIsCalibrating = false;
+                this->mNumOfIntervals = 0;
+            }
+        } else if (isMissed) {
+            // ɊԂɍȂꍇ͗]T𑝂₷
+            this->mSafetyMargin = std::min(
+                this->mSafetyMargin + CFramePacer::SafetyMarginIncrease,
+                CFramePacer::MaxSafetyMargin);
+        } else {
+            // Ԃɍꍇ͗]T炷
+            this->mSafetyMargin = std::max(
+                this->mSafetyMargin - CFramePacer::SafetyMarginDecrease,
+                CFramePacer::MinSafetyMargin);
+
+            // lɋ߂ꍇ͎̊ԊuŐ̊Ԋu␳
+            if (std::abs(interval - this->mNominalFramePeriod) <
+                this->mNominalFramePeriod * CFramePacer::FramePeriodTolerance)
+                this->mFramePeriod = 0.99 * this->mFramePeriod + 0.01 * interval;
+        }
+
+        // ߂̊Ԋu̒ll傫Ăꍇ
+        // (EBhEʂ̃j^ɈړꍇȂ) ̊Ԋu𑪒肵
+        if (!this->mIsCalibrating && this->mNumOfIntervals == CFramePacer::IntervalHistorySize) {
+            if (std::abs(this->GetMedianInterval() - this->mNominalFramePeriod) >
+                this->mNominalFramePeriod * CFramePacer::FramePeriodTolerance)
+                this->StartCalibration();
+            else
+                this->mNumOfIntervals = 0;
+        }
+    }
+
+    this->mLastFlipTime = flipTime;
+    this->mHasLastFlipTime = true;
+}
+
+void CFramePacer::StartCalibration()
+{
+    this->mIsCalibrating = true;
+    this->mIntervalIndex = 0;
+    this->mNumOfIntervals = 0;
+}
+
+double CFramePacer::GetMedianInterval() const
+{
+    double intervals[IntervalHistorySize];
+    std::copy(this->mIntervals, this->mIntervals + this->mNumOfIntervals, intervals);
+    std::nth_element(intervals, intervals + this->mNumOfIntervals / 2, intervals + this->mNumOfIntervals);
+
+    return intervals[this->mNumOfIntervals / 2];
 }
 
-template <typename T>
-inline T ConvertRadianToDegree(T radianValue)
+void CFramePacer::WaitUntil(Clock::time_point wakeUpTime) const
 {
-    return radianValue * static_cast<T>(180.0) / Pi<T>;
+    // c莞ԂԂSleepőҋ@, O̓Xsđҋ@
+    for (;;) {
+        double remainingTime = Milliseconds(wakeUpTime - Clock::now()).count();
+
+        if (remainingTime <= 0.0)
+            return;
+
+        if (remainingTime > CFramePacer::SpinThreshold)
+            ::Sleep(static_cast<DWORD>(remainingTime - CFramePacer::SpinThreshold));
+        else
+            std::this_thread::yield();
+    }
 }
 
 //
-// CArduinoSerialInputNX
-// ȉURLɌfڂĂ\[XR[hςĎgp
-// https://blog.manash.me/serial-communication-with-an-arduino-using-c-on-windows-d08710186498
+// EntityType񋓑
 //
-class CArduinoSerialInput
+enum class EntityType
+{
+    Pipe,           // y
+    MovingPipe,     // ㉺Ɉړy
+    Collectible,    // ƃXRAZACe
+    Hazard,         // GƃQ[I[o[ɂȂQ
+    Count
+};
+
+//
+// CEntityPoolNX
+// ނ̃IuWFNg̊evfz񂲂Ƃɕێ (Structure of Arrays)
+// yǂ̏ꍇYWƏc㉺̓yǂ̌Ԃ\
+//
+class CEntityPool
 {
 public:
-    CArduinoSerialInput(const char* portName);
-    ~CArduinoSerialInput();
+    CEntityPool();
 
-    int Read(char* pBuffer, unsigned int bufferSize);
-    inline bool IsConnected() const { return this->mIsConnected; }
+    void Allocate(std::size_t capacity);
+    bool Add(float positionX, float positionY, float width, float height,
+             float velocityY, float minPositionY, float maxPositionY);
+    void Compact(float minPositionX);
+    inline void Clear() { this->mSize = 0; }
+    inline std::size_t GetSize() const { return this->mSize; }
+
+    static const std::uint8_t FlagPassed = 0x01;    // LN^[ʉ߂
+    static const std::uint8_t FlagRemoved = 0x02;   // ̋lߒŏ
+
+public:
+    std::vector<float> mPositionX;          // [XW
+    std::vector<float> mPositionY;          // [YW
+    std::vector<float> mWidth;              // 
+    std::vector<float> mHeight;             // c
+    std::vector<float> mVelocityY;          // c̑x
+    std::vector<float> mMinPositionY;       // [YW̍ŏl
+    std::vector<float> mMaxPositionY;       // [YW̍ől
+    std::vector<std::uint8_t> mFlags;       // Ԃ\tO
 
 private:
-    HANDLE mHandle;
-    COMSTAT mCommStatus;
-    DWORD mError;
-    bool mIsConnected;
+    std::size_t mSize;                      // LȃIuWFNǧ
 };
 
-CArduinoSerialInput::CArduinoSerialInput(const char* portName)
+CEntityPool::CEntityPool() :
+    mPositionX(),
+    mPositionY(),
+    mWidth(),
+    mHeight(),
+    mVelocityY(),
+    mMinPositionY(),
+    mMaxPositionY(),
+    mFlags(),
+    mSize(0)
 {
-    // VA|[g̐ڑ
-    this->mHandle = ::CreateFileA(
-        static_cast<LPCSTR>(portName), GENERIC_READ | GENERIC_WRITE, 0, NULL,
-        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+}
 
-    if (this->mHandle == INVALID_HANDLE_VALUE) {
-        if (::GetLastError() == ERROR_FILE_NOT_FOUND)
-            ::MessageBoxA(
-                NULL, "Arduino}CR{[hڑĂ܂.",
-                "Error", MB_OK | MB_ICONEXCLAMATION);
-        else
-            ::MessageBoxA(
-                NULL, "Arduino}CR{[hƐڑł܂ł.",
-                "Error", MB_OK | MB_ICONEXCLAMATION);
+void CEntityPool::Allocate(std::size_t capacity)
+{
+    // ő炩ߊmۂ, ȍ~͍ĊmۂȂ
+    this->mPositionX.resize(capacity);
+    this->mPositionY.resize(capacity);
+    this->mWidth.resize(capacity);
+    this->mHeight.resize(capacity);
+    this->mVelocityY.resize(capacity);
+    this->mMinPositionY.resize(capacity);
+    this->mMaxPositionY.resize(capacity);
+    this->mFlags.resize(capacity);
+    this->mSize = 0;
+}
 
-        this->mIsConnected = false;
-        return;
+bool CEntityPool::Add(
+    float positionX, float positionY, float width, float height,
+    float velocityY, float minPositionY, float maxPositionY)
+{
+    // őɒBĂꍇ͒ǉȂ
+    if (this->mSize >= this->mFlags.size())
+        return false;
+
+    std::size_t i = this->mSize++;
+    this->mPositionX[i] = positionX;
+    this->mPositionY[i] = positionY;
+    this->mWidth[i] = width;
+    this->mHeight[i] = height;
+    this->mVelocityY[i] = velocityY;
+    this->mMinPositionY[i] = minPositionY;
+    this->mMaxPositionY[i] = maxPositionY;
+    this->mFlags[i] = 0;
+
+    return true;
+}
+
+void CEntityPool::Compact(float minPositionX)
+{
+    // IuWFNgl߂, c̃IuWFNg̏ۂ
+    std::size_t numOfEntities = 0;
+
+    for (std::size_t i = 0; i < this->mSize; ++i) {
+        if ((this->mFlags[i] & CEntityPool::FlagRemoved) != 0 ||
+            this->mPositionX[i] + this->mWidth[i] < minPositionX)
+            continue;
+
+        if (i != numOfEntities) {
+            this->mPositionX[numOfEntities] = this->mPositionX[i];
+            this->mPositionY[numOfEntities] = this->mPositionY[i];
+            this->mWidth[numOfEntities] = this->mWidth[i];
+            this->mHeight[numOfEntities] = this->mHeight[i];
+            this->mVelocityY[numOfEntities] = this->mVelocityY[i];
+            this->mMinPositionY[numOfEntities] = this->mMinPositionY[i];
+            this->mMaxPositionY[numOfEntities] = this->mMaxPositionY[i];
+            this->mFlags[numOfEntities] = this->mFlags[i];
+        }
+
+        ++numOfEntities;
     }
 
-    // VA|[ǧ݂̃p[^̎擾
-    DCB dcbSerialInputParameters;
-    ZeroMemory(&dcbSerialInputParameters, sizeof(DCB));
+    this->mSize = numOfEntities;
+}
 
-    if (!::GetCommState(this->mHandle, &dcbSerialInputParameters)) {
-        ::MessageBoxA(
-            NULL, "VA|[ǧ݂̃p[^̎擾Ɏs܂.",
-            "Error", MB_OK | MB_ICONEXCLAMATION);
-        this->mIsConnected = false;
-        return;
+//
+// CEntityStorageNX
+// ނƂ̃IuWFNg̔z, ނƂ̍XVێ
+// XV͎xNg悤, ܂܂ȂPȃ[vƂċLq
+//
+class CEntityStorage
+{
+public:
+    CEntityStorage();
+
+    void Allocate(std::size_t capacityPerType);
+    void Clear();
+    void Update(float scrollSpeed);
+    int MarkPassed(float positionX);
+    void Compact(float minPositionX);
+    std::size_t GetSize() const;
+
+    inline CEntityPool& GetPool(EntityType entityType)
+    {
+        return this->mPools[static_cast<int>(entityType)];
     }
 
-    // VA|[g̃p[^̐ݒ
-    dcbSerialInputParameters.BaudRate = CBR_57600;
-    dcbSerialInputParameters.ByteSize = 8;
-    dcbSerialInputParameters.StopBits = ONESTOPBIT;
-    dcbSerialInputParameters.Parity = NOPARITY;
-    dcbSerialInputParameters.fDtrControl = DTR_CONTROL_ENABLE;
+    inline const CEntityPool& GetPool(EntityType entityType) const
+    {
+        return this->mPools[static_cast<int>(entityType)];
+    }
 
-    if (!::SetCommState(this->mHandle, &dcbSerialInputParameters)) {
-        ::MessageBoxA(
-            NULL, "VA|[g̃p[^̐ݒɎs܂.",
-            "Error", MB_OK | MB_ICONEXCLAMATION);
-        this->mIsConnected = false;
-        return;
+    static inline bool IsPipe(EntityType entityType)
+    {
+        return entityType == EntityType::Pipe || entityType == EntityType::MovingPipe;
     }
 
-    // VA|[g̐ڑ̊
-    this->mIsConnected = true;
-    ::PurgeComm(this->mHandle, PURGE_RXCLEAR | PURGE_TXCLEAR);
-    ::Sleep(20);
+private:
+    static void ScrollKernel(float* __restrict pPositionX, int numOfEntities, float scrollSpeed);
+    static void BounceKernel(
+        float* __restrict pPositionY, float* __restrict pVelocityY,
+        const float* __restrict pMinPositionY, const float* __restrict pMaxPositionY,
+        int numOfEntities);
+    static int MarkPassedKernel(
+        const float* __restrict pPositionX, const float* __restrict pWidth,
+        std::uint8_t* __restrict pFlags, int numOfEntities, float positionX);
+
+private:
+    CEntityPool mPools[static_cast<int>(EntityType::Count)];   // ނƂ̃IuWFNg̔z
+};
+
+CEntityStorage::CEntityStorage() :
+    mPools()
+{
 }
 
-CArduinoSerialInput::~CArduinoSerialInput()
+void CEntityStorage::Allocate(std::size_t capacityPerType)
 {
-    if (this->mIsConnected) {
-        ::CloseHandle(this->mHandle);
-        this->mIsConnected = false;
+    for (auto& entityPool : this->mPools)
+        entityPool.Allocate(capacityPerType);
+}
+
+void CEntityStorage::Clear()
+{
+    for (auto& entityPool : this->mPools)
+        entityPool.Clear();
+}
+
+void CEntityStorage::Update(float scrollSpeed)
+{
+    // SĂ̎ނ̃IuWFNgֈړ
+    for (auto& entityPool : this->mPools)
+        CEntityStorage::ScrollKernel(
+            entityPool.mPositionX.data(), static_cast<int>(entityPool.GetSize()), scrollSpeed);
+
+    // ㉺ɈړyǂƏQ͔͈͂̒[Ő܂Ԃ
+    for (EntityType entityType : { EntityType::MovingPipe, EntityType::Hazard }) {
+        CEntityPool& entityPool = this->GetPool(entityType);
+        CEntityStorage::BounceKernel(
+            entityPool.mPositionY.data(), entityPool.mVelocityY.data(),
+            entityPool.mMinPositionY.data(), entityPool.mMaxPositionY.data(),
+            static_cast<int>(entityPool.GetSize()));
     }
 }
 
-int CArduinoSerialInput::Read(char* pBuffer, unsigned int bufferSize)
+int CEntityStorage::MarkPassed(float positionX)
 {
-    DWORD numOfBytesRead = 0;
-    DWORD numOfBytesToRead = 0;
-    DWORD bytesRead;
-    
-    ::ClearCommError(this->mHandle, &this->mError, &this->mCommStatus);
+    // VɃLN^[ʉ߂yǂ̌𐔂
+    int numOfPassedPipes = 0;
+
+    for (EntityType entityType : { EntityType::Pipe, EntityType::MovingPipe }) {
+        CEntityPool& entityPool = this->GetPool(entityType);
+        numOfPassedPipes += CEntityStorage::MarkPassedKernel(
+            entityPool.mPositionX.data(), entityPool.mWidth.data(), entityPool.mFlags.data(),
+            static_cast<int>(entityPool.GetSize()), positionX);
+    }
 
-    if (this->mCommStatus.cbInQue > 0)
-        if (this->mCommStatus.cbInQue > bufferSize)
-            numOfBytesToRead = bufferSize;
-        else
-            numOfBytesToRead = this->mCommStatus.cbInQue;
+    return numOfPassedPipes;
+}
+
+void CEntityStorage::Compact(float minPositionX)
+{
+    for (auto& entityPool : this->mPools)
+        entityPool.Compact(minPositionX);
+}
 
-    for (DWORD i = 0; i < numOfBytesToRead; ++i) {
-        if (!::ReadFile(this->mHandle, &pBuffer[i], 1, &bytesRead, NULL))
-            return numOfBytesRead;
+std::size_t CEntityStorage::GetSize() const
+{
+    std::size_t numOfEntities = 0;
+
+    for (const auto& entityPool : this->mPools)
+        numOfEntities += entityPool.GetSize();
+
+    return numOfEntities;
+}
+
+void CEntityStorage::ScrollKernel(float* __restrict pPositionX, int numOfEntities, float scrollSpeed)
+{
+    for (int i = 0; i < numOfEntities; ++i)
+        pPositionX[i] -= scrollSpeed;
+}
+
+void CEntityStorage::BounceKernel(
+    float* __restrict pPositionY, float* __restrict pVelocityY,
+    const float* __restrict pMinPositionY, const float* __restrict pMaxPositionY,
+    int numOfEntities)
+{
+    for (int i = 0; i < numOfEntities; ++i) {
+        float positionY = pPositionY[i] + pVelocityY[i];
+        bool isOutOfRange = positionY < pMinPositionY[i] || positionY > pMaxPositionY[i];
+
+        // ͈͊Oɏo瑬x𔽓], ͈͓Ɏ߂
+        pVelocityY[i] = isOutOfRange ? -pVelocityY[i] : pVelocityY[i];
+        pPositionY[i] = std::min(std::max(positionY, pMinPositionY[i]), pMaxPositionY[i]);
+    }
+}
 
-        ++numOfBytesRead;
+int CEntityStorage::MarkPassedKernel(
+    const float* __restrict pPositionX, const float* __restrict pWidth,
+    std::uint8_t* __restrict pFlags, int numOfEntities, float positionX)
+{
+    int numOfPassedEntities = 0;
+
+    for (int i = 0; i < numOfEntities; ++i) {
+        std::uint8_t passedFlag =
+            (pPositionX[i] + pWidth[i] <= positionX) ? CEntityPool::FlagPassed : 0;
 
-        // sR[hoǂݍ݂I
-        if (pBuffer[i] == '\n')
-            return numOfBytesRead;
+        // 񏉂߂Ēʉ߂̂𐔂
+        numOfPassedEntities += (passedFlag & ~pFlags[i]) != 0 ? 1 : 0;
+        pFlags[i] |= passedFlag;
     }
 
-    return 0;
+    return numOfPassedEntities;
 }
 
 //
-// PipeObject\
+// CUniformGridNX
+// ʂ̑傫̃Zɕ, eZƏdȂIuWFNg񋓂 (Փ˔̌̍i荞)
+// et[Ōv\[gɂ\z
+// z͏ɃIuWFNg̍ő吔ƍő̑傫mۂ, \zɂ͊mۂȂ
 //
-struct PipeObject
+class CUniformGrid
 {
-    int mPositionX;             // yǂ̍[XW
-    int mTopPipeHeight;         // 㑤̓yǂ̍
-    int mBottomPipeHeight;      // ̓yǂ̍
-    bool mPassed;               // yǂʉ߂ǂ
+public:
+    CUniformGrid();
+
+    void Initialize(float originX, float originY, float width, float height, float cellSize,
+                    std::size_t maxEntities, float maxEntityWidth, float maxEntityHeight);
+    void Build(const CEntityStorage& entityStorage, float pipeBottomY);
+
+    template <typename TCallback>
+    void Query(float left, float top, float right, float bottom, TCallback callback) const;
+
+private:
+    void GetCellRange(
+        float left, float top, float right, float bottom,
+        int& cellLeft, int& cellTop, int& cellRight, int& cellBottom) const;
+    void GetEntityBounds(
+        const CEntityStorage& entityStorage, EntityType entityType, std::size_t i,
+        float pipeBottomY, float& left, float& top, float& right, float& bottom) const;
+
+    static inline std::uint32_t MakeEntry(EntityType entityType, std::size_t i)
+    {
+        return (static_cast<std::uint32_t>(entityType) << 24) | static_cast<std::uint32_t>(i);
+    }
+
+    //
+    // CellRange\
+    //
+    struct CellRange
+    {
+        std::uint16_t mLeft;                    // [̃Z
+        std::uint16_t mTop;                     // [̃Z
+        std::uint16_t mRight;                   // E[̃Z
+        std::uint16_t mBottom;                  // [̃Z
+    };
+
+private:
+    float mOriginX;                             // Obh̍[XW
+    float mOriginY;                             // Obh̏[YW
+    float mInverseCellSize;                     // Z̑傫̋t
+    int mNumOfCellsX;                           // ̃Z
+    int mNumOfCellsY;                           // c̃Z
+    std::vector<std::uint32_t> mCellStarts;     // eZ̃IuWFNg̊Jnʒu
+    std::vector<std::uint32_t> mCellOffsets;    // \z̊eZ݈̏ʒu
+    std::vector<std::uint32_t> mEntries;        // ZƂɕׂIuWFNg (8rbg)
+    std::vector<CellRange> mCellRanges;         // \z̊eIuWFNgƏdȂZ͈̔
 };
 
+CUniformGrid::CUniformGrid() :
+    mOriginX(0.0f),
+    mOriginY(0.0f),
+    mInverseCellSize(1.0f),
+    mNumOfCellsX(0),
+    mNumOfCellsY(0),
+    mCellStarts(),
+    mCellOffsets(),
+    mEntries(),
+    mCellRanges()
+{
+}
+
+void CUniformGrid::Initialize(float originX, float originY, float width, float height, float cellSize,
+                              std::size_t maxEntities, float maxEntityWidth, float maxEntityHeight)
+{
+    this->mOriginX = originX;
+    this->mOriginY = originY;
+    this->mInverseCellSize = 1.0f / cellSize;
+    this->mNumOfCellsX = std::max(1, static_cast<int>(std::ceil(width / cellSize)));
+    this->mNumOfCellsY = std::max(1, static_cast<int>(std::ceil(height / cellSize)));
+
+    std::size_t numOfCells = static_cast<std::size_t>(this->mNumOfCellsX * this->mNumOfCellsY);
+    this->mCellStarts.assign(numOfCells + 1, 0);
+    this->mCellOffsets.assign(numOfCells, 0);
+
+    // 1̃IuWFNgƏdȂZ̍ől (Z̋E܂1)
+    int maxCellsX = std::min(static_cast<int>(maxEntityWidth * this->mInverseCellSize) + 2, this->mNumOfCellsX);
+    int maxCellsY = std::min(static_cast<int>(maxEntityHeight * this->mInverseCellSize) + 2, this->mNumOfCellsY);
+    std::size_t maxCellsPerEntity = static_cast<std::size_t>(maxCellsX * maxCellsY);
+
+    this->mCellRanges.resize(maxEntities);
+    this->mEntries.resize(maxEntities * maxCellsPerEntity);
+}
+
+void CUniformGrid::Build(const CEntityStorage& entityStorage, float pipeBottomY)
+{
+    std::fill(this->mCellOffsets.begin(), this->mCellOffsets.end(), 0);
+
+    assert(entityStorage.GetSize() <= this->mCellRanges.size());
+
+    // 1: eIuWFNgƏdȂZ͈̔͂, eZƏdȂIuWFNǧ𐔂
+    std::size_t numOfEntities = 0;
+
+    for (int type = 0; type < static_cast<int>(EntityType::Count); ++type) {
+        EntityType entityType = static_cast<EntityType>(type);
+        std::size_t poolSize = entityStorage.GetPool(entityType).GetSize();
+
+        for (std::size_t i = 0; i < poolSize; ++i) {
+            float left, top, right, bottom;
+            int cellLeft, cellTop, cellRight, cellBottom;
+            this->GetEntityBounds(entityStorage, entityType, i, pipeBottomY, left, top, right, bottom);
+            this->GetCellRange(left, top, right, bottom, cellLeft, cellTop, cellRight, cellBottom);
+
+            for (int y = cellTop; y <= cellBottom; ++y)
+                for (int x = cellLeft; x <= cellRight; ++x)
+                    this->mCellOffsets[y * this->mNumOfCellsX + x]++;
+
+            this->mCellRanges[numOfEntities++] = CellRange {
+                static_cast<std::uint16_t>(cellLeft), static_cast<std::uint16_t>(cellTop),
+                static_cast<std::uint16_t>(cellRight), static_cast<std::uint16_t>(cellBottom) };
+        }
+    }
+
+    // eZ̊Jnʒu߂
+    std::uint32_t numOfEntries = 0;
+
+    for (std::size_t cell = 0; cell < this->mCellOffsets.size(); ++cell) {
+        this->mCellStarts[cell] = numOfEntries;
+        numOfEntries += this->mCellOffsets[cell];
+        this->mCellOffsets[cell] = this->mCellStarts[cell];
+    }
+
+    this->mCellStarts.back() = numOfEntries;
+
+    assert(numOfEntries <= this->mEntries.size());
+
+    // 2: eZɃIuWFNgi[
+    numOfEntities = 0;
+
+    for (int type = 0; type < static_cast<int>(EntityType::Count); ++type) {
+        EntityType entityType = static_cast<EntityType>(type);
+        std::size_t poolSize = entityStorage.GetPool(entityType).GetSize();
+
+        for (std::size_t i = 0; i < poolSize; ++i) {
+            const CellRange& cellRange = this->mCellRanges[numOfEntities++];
+            std::uint32_t entry = CUniformGrid::MakeEntry(entityType, i);
+
+            for (int y = cellRange.mTop; y <= cellRange.mBottom; ++y)
+                for (int x = cellRange.mLeft; x <= cellRange.mRight; ++x)
+                    this->mEntries[this->mCellOffsets[y * this->mNumOfCellsX + x]++] = entry;
+        }
+    }
+}
+
+template <typename TCallback>
+void CUniformGrid::Query(float left, float top, float right, float bottom, TCallback callback) const
+{
+    // w肵͈͂ƏdȂZ̃IuWFNg
+    // ̃Zɂ܂IuWFNg͕񋓂
+    int cellLeft, cellTop, cellRight, cellBottom;
+    this->GetCellRange(left, top, right, bottom, cellLeft, cellTop, cellRight, cellBottom);
+
+    for (int y = cellTop; y <= cellBottom; ++y) {
+        for (int x = cellLeft; x <= cellRight; ++x) {
+            int cell = y * this->mNumOfCellsX + x;
+
+            for (std::uint32_t j = this->mCellStarts[cell]; j < this->mCellStarts[cell + 1]; ++j) {
+                std::uint32_t entry = this->mEntries[j];
+                callback(static_cast<EntityType>(entry >> 24),
+                         static_cast<std::size_t>(entry & 0x00FFFFFF));
+            }
+        }
+    }
+}
+
+void CUniformGrid::GetCellRange(
+    float left, float top, float right, float bottom,
+    int& cellLeft, int& cellTop, int& cellRight, int& cellBottom) const
+{
+    // Obh̊O͒[̃ZɊ܂߂ (̒l0ɐ؂l߂邽ߐ؂̂Ă͕sv)
+    auto toCell = [](float position, float origin, float inverseCellSize, int numOfCells) {
+        float cell = std::min(
+            std::max((position - origin) * inverseCellSize, 0.0f),
+            static_cast<float>(numOfCells - 1));
+        return static_cast<int>(cell);
+    };
+
+    cellLeft = toCell(left, this->mOriginX, this->mInverseCellSize, this->mNumOfCellsX);
+    cellRight = toCell(right, this->mOriginX, this->mInverseCellSize, this->mNumOfCellsX);
+    cellTop = toCell(top, this->mOriginY, this->mInverseCellSize, this->mNumOfCellsY);
+    cellBottom = toCell(bottom, this->mOriginY, this->mInverseCellSize, this->mNumOfCellsY);
+}
+
+void CUniformGrid::GetEntityBounds(
+    const CEntityStorage& entityStorage, EntityType entityType, std::size_t i,
+    float pipeBottomY, float& left, float& top, float& right, float& bottom) const
+{
+    const CEntityPool& entityPool = entityStorage.GetPool(entityType);
+
+    left = entityPool.mPositionX[i];
+    right = entityPool.mPositionX[i] + entityPool.mWidth[i];
+
+    // yǂ͌ԈȊȌcŜ߂
+    if (CEntityStorage::IsPipe(entityType)) {
+        top = 0.0f;
+        bottom = pipeBottomY;
+    } else {
+        top = entityPool.mPositionY[i];
+        bottom = entityPool.mPositionY[i] + entityPool.mHeight[i];
+    }
+}
+
 //
 // GameState񋓑
 //
@@ -184,12 +2203,17 @@ private:
     void LoadImages();
     void LoadFonts();
     void InitializeParameters();
+    void GenerateEntities();
+    void ChangeGameState(GameState gameState);
     void Update();
     void Draw();
+    void DrawConnectionStatus();
 
 private:
-    CArduinoSerialInput* mArduinoInput;     // VA|[g̓
-    char* mSerialInputBuffer;               // ̓obt@
+    CArduinoConnection* mArduinoConnection;             // Arduino}CR{[hƂ̐ڑ
+    std::vector<ArduinoSample> mArduinoSamples;         // Mς݂̃ZT̏o͒l
+    CInputPredictor mInputPredictor;                    // ZT̏o͒l̊O}
+    CFramePacer mFramePacer;                            // t[̏̊Jn̒
     double mInputValue;                     // ZT̓͒l
     double mOldInputValue;                  // 1ÕZT̓͒l
 
@@ -227,7 +2251,12 @@ private:
     int mPipeGenerateCounter;               // yǂ̏oJE^
     int mPipeGenerateCounterThreshold;      // yǂo邽߂ɕKvȓyǂ̃JE^l臒l
     int mPipeGap;                           // ㉺̓yǂ̊Ԋu
-    std::vector<PipeObject> mPipeObjects;   // yǃIuWFNg̃Xg
+    int mCollectibleSize;                   // ACȇ傫
+    int mHazardSize;                        // Q̑傫
+    int mMovingPipeMinScore;                // ㉺Ɉړyǂon߂XRA
+    int mHazardMinScore;                    // Qon߂XRA
+    CEntityStorage mEntities;               // y, ACe, Q̃IuWFNg
+    CUniformGrid mEntityGrid;               // Փ˔̌̍i荞݂ɗpObh
 
     int mFontHandle;                        // tHg̃nh
 
@@ -240,8 +2269,10 @@ private:
     static const int WindowHeight;          // EBhȄc
     static const int ColorBitDepth;         // J[rbg
     static const int RefreshRate;           // t[[g
-    static const char* PortName;            // ڑ|[g
-    static const int SerialInputBufferSize; // ̓obt@̃TCY
+    static const char* PortName;            // ŏɐڑ݂|[g
+    static const char* EventLogDirectoryName;   // CxgȌõfBNg
+    static const char* ConfigFileName;      // ݒt@C
+    static const int MaxEntitiesPerType;    // ނƂ̃IuWFNg̍ő吔
 };
 
 const char* CGame::ApplicationName = "ArduinoGame";     // AvP[V
@@ -249,8 +2280,10 @@ const int CGame::WindowWidth = 768;                     // 
 const int CGame::WindowHeight = 1024;                   // EBhȄc
 const int CGame::ColorBitDepth = 32;                    // J[rbg
 const int CGame::RefreshRate = 60;                      // t[[g
-const char* CGame::PortName = "\\\\.\\COM3";            // ڑ|[g
-const int CGame::SerialInputBufferSize = 256;           // ̓obt@̃TCY
+const char* CGame::PortName = "\\\\.\\COM3";            // ŏɐڑ݂|[g
+const char* CGame::EventLogDirectoryName = ".\\EventLogs"; // CxgȌõfBNg
+const char* CGame::ConfigFileName = ".\\ArduinoGame.ini"; // ݒt@C
+const int CGame::MaxEntitiesPerType = 4096;             // ނƂ̃IuWFNg̍ő吔
 
 CGame* CGame::GetInstance()
 {
@@ -259,8 +2292,10 @@ CGame* CGame::GetInstance()
 }
 
 CGame::CGame() :
-    mArduinoInput(nullptr),
-    mSerialInputBuffer(nullptr),
+    mArduinoConnection(nullptr),
+    mArduinoSamples(),
+    mInputPredictor(),
+    mFramePacer(CGame::RefreshRate),
     mInputValue(0.0),
     mOldInputValue(0.0),
     mGameState(GameState::Start),
@@ -291,7 +2326,12 @@ CGame::CGame() :
     mPipeGenerateCounter(0),
     mPipeGenerateCounterThreshold(0),
     mPipeGap(0),
-    mPipeObjects(),
+    mCollectibleSize(0),
+    mHazardSize(0),
+    mMovingPipeMinScore(0),
+    mHazardMinScore(0),
+    mEntities(),
+    mEntityGrid(),
     mFontHandle(0),
     mScore(0),
     mBestScore(0),
@@ -301,72 +2341,49 @@ CGame::CGame() :
 
 bool CGame::InitializeArduinoInput()
 {
-    // ̓obt@̊m
-    this->mSerialInputBuffer = new char[CGame::SerialInputBufferSize];
-
-    if (this->mSerialInputBuffer == nullptr)
-        return false;
-
-    // VA|[gڑ̏
-    this->mArduinoInput = new CArduinoSerialInput(CGame::PortName);
-
-    if (this->mArduinoInput == nullptr) {
-        ::MessageBoxA(
-            NULL, "Arduino}CR{[hƂ̐ڑɎs܂.",
-            CGame::ApplicationName, MB_OK | MB_ICONEXCLAMATION);
-        return false;
-    }
-
-    if (!this->mArduinoInput->IsConnected()) {
-        ::MessageBoxA(
-            NULL, "Arduino}CR{[hƂ̐ڑɎs܂.",
-            CGame::ApplicationName, MB_OK | MB_ICONEXCLAMATION);
-        return false;
-    }
-
-    ::MessageBoxA(
-        NULL, "Arduino}CR{[hƂ̐ڑm܂.",
-        CGame::ApplicationName, MB_OK | MB_ICONINFORMATION);
+    // {[h̐ݒ̓ǂݍ (ݒt@CȂꍇ͕ύXȂ)
+    ArduinoDeviceConfig deviceConfig;
+    deviceConfig.mSamplingRate = static_cast<int>(::GetPrivateProfileIntA(
+        "Device", "SamplingRate", 0, CGame::ConfigFileName));
+    deviceConfig.mBatchSize = static_cast<int>(::GetPrivateProfileIntA(
+        "Device", "BatchSize", 0, CGame::ConfigFileName));
+    deviceConfig.mBaudRate = static_cast<int>(::GetPrivateProfileIntA(
+        "Device", "BaudRate", 0, CGame::ConfigFileName));
+
+    // VA|[gڑ̊Jn
+    // |[g̒TƐڑ͕ʃXbhōs, ł͑ҋ@Ȃ
+    this->mArduinoConnection = new CArduinoConnection(CGame::PortName, deviceConfig);
+    this->mArduinoConnection->Start();
+
+    // Mς݂̃ZT̏o͒l̊i[m
+    this->mArduinoSamples.reserve(256);
 
     return true;
 }
 
 void CGame::FinalizeArduinoInput()
 {
-    if (this->mSerialInputBuffer != nullptr) {
-        delete[] this->mSerialInputBuffer;
-        this->mSerialInputBuffer = nullptr;
-    }
-
-    if (this->mArduinoInput != nullptr) {
-        delete this->mArduinoInput;
-        this->mArduinoInput = nullptr;
+    if (this->mArduinoConnection != nullptr) {
+        this->mArduinoConnection->Stop();
+        delete this->mArduinoConnection;
+        this->mArduinoConnection = nullptr;
     }
 }
 
 void CGame::HandleInput()
 {
-    // VA|[gf[^擾
-    int bytesRead = this->mArduinoInput->Read(
-        this->mSerialInputBuffer, CGame::SerialInputBufferSize);
-    
-    if (!bytesRead)
-        return;
+    // Õt[ȍ~ɎMZT̏o͒l擾
+    this->mArduinoConnection->FetchSamples(this->mArduinoSamples);
 
-    this->mSerialInputBuffer[bytesRead] = '\0';
+    for (const auto& sample : this->mArduinoSamples)
+        this->mInputPredictor.AddSample(sample);
 
-    // ZT̏o͒l̃fobOo
-    // ::OutputDebugStringA(static_cast<LPCSTR>(this->mSerialInputBuffer));
+    // ZT̏o͒lʂɕ\鎞܂ŊO}
+    // (VɎMĂȂt[łO}lXV)
+    double predictedValue;
 
-    // ZT̏o͒l̓ǂݍ
-    int inputValue;
-    int inputValueDummy;
-
-    if (sscanf_s(this->mSerialInputBuffer, "%d,%d", &inputValue, &inputValueDummy) != 2)
-        return;
-
-    // wdݕtړς̌vZ
-    this->mInputValue = 0.95 * this->mInputValue + 0.05 * static_cast<double>(inputValue);
+    if (this->mInputPredictor.Predict(this->mFramePacer.GetPresentTime(), predictedValue))
+        this->mInputValue = predictedValue;
 }
 
 void CGame::LoadImages()
@@ -441,6 +2458,82 @@ void CGame::InitializeParameters()
 
     // ̃Aj[V̐؂ւ臒l̐ݒ
     this->mBirdAnimationCounterThreshold = 62;
+
+    // ACeƏQ̑傫̐ݒ
+    this->mCollectibleSize = 32;
+    this->mHazardSize = 48;
+
+    // ㉺ɈړyǂƏQon߂XRA̐ݒ
+    this->mMovingPipeMinScore = 5;
+    this->mHazardMinScore = 10;
+
+    // IuWFNg̔z̊m (vC͍ĊmۂȂ)
+    this->mEntities.Allocate(static_cast<std::size_t>(CGame::MaxEntitiesPerType));
+
+    // Փ˔̃Obh̏ (ʂ̍Eɂ͂ݏoIuWFNg܂߂)
+    // yǂ͏cŜ߂邽, IuWFNg̍̍ől̓Obh̍Ƃ
+    float gridHeight = static_cast<float>(CGame::WindowHeight - this->mImageGroundHeight);
+    float maxEntityWidth = static_cast<float>(
+        std::max(this->mImagePipeWidth, std::max(this->mCollectibleSize, this->mHazardSize)));
+
+    this->mEntityGrid.Initialize(
+        static_cast<float>(-this->mImagePipeWidth), 0.0f,
+        static_cast<float>(CGame::WindowWidth + this->mImagePipeWidth * 8),
+        gridHeight, 128.0f,
+        static_cast<std::size_t>(CGame::MaxEntitiesPerType) * static_cast<std::size_t>(EntityType::Count),
+        maxEntityWidth, gridHeight);
+}
+
+void CGame::GenerateEntities()
+{
+    float groundPositionY = static_cast<float>(CGame::WindowHeight - this->mImageGroundHeight);
+    float pipePositionX = static_cast<float>(CGame::WindowWidth + 128);
+    float pipeWidth = static_cast<float>(this->mImagePipeWidth);
+    float pipeGap = static_cast<float>(this->mPipeGap);
+    float maxGapPositionY = groundPositionY - pipeGap;
+    float gapPositionY = static_cast<float>(DxLib::GetRand(static_cast<int>(maxGapPositionY)));
+
+    if (this->mScore >= this->mMovingPipeMinScore && DxLib::GetRand(99) < 30) {
+        // ㉺Ɉړyǂ̍쐬
+        float velocityY = DxLib::GetRand(1) == 0 ? 2.0f : -2.0f;
+        this->mEntities.GetPool(EntityType::MovingPipe).Add(
+            pipePositionX, gapPositionY, pipeWidth, pipeGap, velocityY, 0.0f, maxGapPositionY);
+    } else {
+        // Vyǂ̍쐬
+        this->mEntities.GetPool(EntityType::Pipe).Add(
+            pipePositionX, gapPositionY, pipeWidth, pipeGap, 0.0f, gapPositionY, gapPositionY);
+
+        // yǂ̌Ԃ̒ɃACezu
+        if (DxLib::GetRand(1) == 0) {
+            float collectibleSize = static_cast<float>(this->mCollectibleSize);
+            float collectiblePositionY = gapPositionY + (pipeGap - collectibleSize) / 2.0f;
+            this->mEntities.GetPool(EntityType::Collectible).Add(
+                pipePositionX + (pipeWidth - collectibleSize) / 2.0f, collectiblePositionY,
+                collectibleSize, collectibleSize, 0.0f, collectiblePositionY, collectiblePositionY);
+        }
+    }
+
+    // yǂƎ̓yǂ̊Ԃɏ㉺ɈړQzu
+    if (this->mScore >= this->mHazardMinScore && DxLib::GetRand(99) < 25) {
+        float hazardSize = static_cast<float>(this->mHazardSize);
+        float pipeInterval = static_cast<float>(this->mPipeGenerateCounterThreshold * 4);
+        float maxHazardPositionY = groundPositionY - hazardSize;
+        float velocityY = DxLib::GetRand(1) == 0 ? 3.0f : -3.0f;
+        this->mEntities.GetPool(EntityType::Hazard).Add(
+            pipePositionX + (pipeWidth + pipeInterval - hazardSize) / 2.0f,
+            static_cast<float>(DxLib::GetRand(static_cast<int>(maxHazardPositionY))),
+            hazardSize, hazardSize, velocityY, 0.0f, maxHazardPositionY);
+    }
+}
+
+void CGame::ChangeGameState(GameState gameState)
+{
+    // Ԃ̑Jڂ̎_̃XRAƂƂɋL^
+    CEventLog::GetInstance()->Write(
+        EventType::StateTransition, static_cast<std::uint32_t>(this->mGameState),
+        static_cast<std::int64_t>(gameState), this->mScore);
+
+    this->mGameState = gameState;
 }
 
 void CGame::Update()
@@ -464,7 +2557,7 @@ void CGame::Update()
 
             // LN^[̍W臒lvCʂ֑J
             if (this->mBirdPositionY < this->mGamePlayThresholdPositionY)
-                this->mGameState = GameState::Play;
+                this->ChangeGameState(GameState::Play);
 
             break;
         }
@@ -476,19 +2569,8 @@ void CGame::Update()
                 this->mBirdPositionMaxY,
                 CGame::WindowHeight - static_cast<int>(this->mInputValue) - this->mBirdHeight);
 
-            // yǂ̈ړ
-            for (auto& pipeObject : this->mPipeObjects)
-                pipeObject.mPositionX -= 4;
-
-            // ʂ͂ݏoyǂ
-            this->mPipeObjects.erase(
-                std::remove_if(
-                    this->mPipeObjects.begin(),
-                    this->mPipeObjects.end(),
-                    [this](const PipeObject& pipeObject) {
-                        return pipeObject.mPositionX < -this->mImagePipeWidth;
-                }),
-                this->mPipeObjects.end());
+            // y, ACe, Q̈ړ
+            this->mEntities.Update(4.0f);
 
             // yǂ̏oJE^̍XV
             this->mPipeGenerateCounter++;
@@ -496,44 +2578,60 @@ void CGame::Update()
             // yǂ̏oJE^lo
             if (this->mPipeGenerateCounter >= this->mPipeGenerateCounterThreshold) {
                 this->mPipeGenerateCounter = 0;
-
-                // VyǃIuWFNg̍쐬
-                PipeObject pipeObject;
-                pipeObject.mPositionX = CGame::WindowWidth + 128;
-                pipeObject.mTopPipeHeight =
-                    DxLib::GetRand(CGame::WindowHeight - this->mImageGroundHeight - this->mPipeGap);
-                pipeObject.mBottomPipeHeight =
-                    CGame::WindowHeight - this->mImageGroundHeight -
-                    pipeObject.mTopPipeHeight - this->mPipeGap;
-                pipeObject.mPassed = false;
-
-                // VyǃIuWFNg̒ǉ
-                this->mPipeObjects.push_back(pipeObject);
+                this->GenerateEntities();
             }
 
-            // yǂƃLN^̏Փ˂̌m
-            auto collidePipeIterator = std::find_if(
-                this->mPipeObjects.begin(), this->mPipeObjects.end(),
-                [this](const PipeObject& pipeObject) {
-                    // yǂƂ̏Փ˔()
-                    if (this->mBirdPositionX < pipeObject.mPositionX + this->mImagePipeWidth &&
-                        this->mBirdPositionX + this->mBirdWidth > pipeObject.mPositionX)
-                        // 㑤̓yǂƂ̏Փ˔(c)
-                        if (this->mBirdPositionY < pipeObject.mTopPipeHeight &&
-                            this->mBirdPositionY + this->mBirdHeight > 0.0)
-                            return true;
-                        // ̓yǂƂ̏Փ˔(c)
-                        else if (this->mBirdPositionY < CGame::WindowHeight - this->mImageGroundHeight &&
-                            this->mBirdPositionY + this->mBirdHeight >
-                            CGame::WindowHeight - this->mImageGroundHeight - pipeObject.mBottomPipeHeight)
-                            return true;
-
-                    return false;
-            });
-            
+            // Փ˔̌i荞ނ߂̃Obh̍\z
+            float groundPositionY = static_cast<float>(CGame::WindowHeight - this->mImageGroundHeight);
+            this->mEntityGrid.Build(this->mEntities, groundPositionY);
+
+            // IuWFNgƃLN^̏Փ˂̌m
+            float birdLeft = static_cast<float>(this->mBirdPositionX);
+            float birdTop = static_cast<float>(this->mBirdPositionY);
+            float birdRight = static_cast<float>(this->mBirdPositionX + this->mBirdWidth);
+            float birdBottom = static_cast<float>(this->mBirdPositionY + this->mBirdHeight);
+            bool isCollided = false;
+
+            this->mEntityGrid.Query(
+                birdLeft, birdTop, birdRight, birdBottom,
+                [&](EntityType entityType, std::size_t i) {
+                    CEntityPool& entityPool = this->mEntities.GetPool(entityType);
+                    float left = entityPool.mPositionX[i];
+                    float top = entityPool.mPositionY[i];
+                    float right = left + entityPool.mWidth[i];
+                    float bottom = top + entityPool.mHeight[i];
+
+                    // Փ˔()
+                    if (!(birdLeft < right && birdRight > left))
+                        return;
+
+                    // ㉺̓yǂƂ̏Փ˔(c) (Ԃ͂ݏoĂΏՓ)
+                    if (CEntityStorage::IsPipe(entityType)) {
+                        if (birdTop < top || birdBottom > bottom)
+                            isCollided = true;
+                        return;
+                    }
+
+                    // ACeƏQƂ̏Փ˔(c)
+                    if (!(birdTop < bottom && birdBottom > top))
+                        return;
+
+                    if (entityType == EntityType::Hazard) {
+                        isCollided = true;
+                    } else if ((entityPool.mFlags[i] & CEntityPool::FlagRemoved) == 0) {
+                        // ACeXRAZ (̃Z񋓂Ă1̂)
+                        entityPool.mFlags[i] |= CEntityPool::FlagRemoved;
+                        this->mScore++;
+
+                        CEventLog::GetInstance()->Write(
+                            EventType::Score, static_cast<std::uint32_t>(ScoreReason::Collectible),
+                            1, this->mScore);
+                    }
+                });
+
             // Փ˂Q[I[o[ʂ֑J
-            if (collidePipeIterator != this->mPipeObjects.end()) {
-                this->mGameState = GameState::GameOver;
+            if (isCollided) {
+                this->ChangeGameState(GameState::GameOver);
 
                 // xXgXRAƔrČ݂̃XRA̕傫΍XV
                 this->mBestScore = std::max(this->mBestScore, this->mScore);
@@ -541,19 +2639,22 @@ void CGame::Update()
                 // ZT̓͒l̃NA
                 this->mInputValue = 0.0;
                 this->mOldInputValue = 0.0;
+                this->mInputPredictor.Reset(0.0);
             }
 
             // yǂLN^ʂ蔲ǂ𒲂ׂ, Vɒʂ蔲yǂ΃XRAZ
-            std::for_each(
-                this->mPipeObjects.begin(),
-                this->mPipeObjects.end(),
-                [this](PipeObject& pipeObject) {
-                    if (!pipeObject.mPassed &&
-                        pipeObject.mPositionX + this->mImagePipeWidth <= this->mBirdPositionX) {
-                        pipeObject.mPassed = true;
-                        this->mScore++;
-                    }
-                });
+            int numOfPassedPipes = this->mEntities.MarkPassed(birdLeft);
+
+            if (numOfPassedPipes > 0) {
+                this->mScore += numOfPassedPipes;
+
+                CEventLog::GetInstance()->Write(
+                    EventType::Score, static_cast<std::uint32_t>(ScoreReason::PipePassed),
+                    numOfPassedPipes, this->mScore);
+            }
+
+            // ʂ͂ݏoIuWFNgƎꂽACe
+            this->mEntities.Compact(0.0f);
 
             break;
         }
@@ -567,17 +2668,18 @@ void CGame::Update()
 
             // ZT̓͒l臒l𒴂烊X^[g
             if (this->mInputValue > this->mRestartThresholdPositionY) {
-                this->mGameState = GameState::Start;
+                this->ChangeGameState(GameState::Start);
 
                 // ZT̓͒l̃NA
                 this->mInputValue = 0.0;
                 this->mOldInputValue = 0.0;
+                this->mInputPredictor.Reset(0.0);
 
                 // yǂ̏oJE^̃Zbg
                 this->mPipeGenerateCounter = 0;
 
-                // yǃIuWFNg̃Xg̃NA
-                this->mPipeObjects.clear();
+                // y, ACe, Q̃NA
+                this->mEntities.Clear();
 
                 // XRÃZbg
                 this->mScore = 0;
@@ -589,16 +2691,6 @@ void CGame::Update()
 
 void CGame::Draw()
 {
-    // fobOo
-    /*
-    DxLib::clsDx();
-    DxLib::printfDx("%s\n",
-        (this->mGameState == GameState::Start) ? "GameState::Start" :
-        (this->mGameState == GameState::Play) ? "GameState::Play" :
-        (this->mGameState == GameState::GameOver) ? "GameState::GameOver" : "Unknown");
-    DxLib::printfDx("%u", this->mPipeObjects.size());
-    */
-
     // wi摜̕`
     DxLib::DrawGraph(0, 0, this->mImageHandleBackground, FALSE);
 
@@ -615,20 +2707,68 @@ void CGame::Draw()
 
         case GameState::Play:
         {
+            // ʂ̍E̊OɂIuWFNg͕`悵Ȃ
+            // (IuWFNg͉ʂ̉E[̊OŐ邽, `̌Ăяoʓ̌ɗ})
+            auto isVisible = [](const CEntityPool& entityPool, std::size_t i) {
+                return entityPool.mPositionX[i] + entityPool.mWidth[i] >= 0.0f &&
+                       entityPool.mPositionX[i] < static_cast<float>(CGame::WindowWidth);
+            };
+
             // yǂ̕`
-            for (const auto& pipeObject : this->mPipeObjects) {
-                // yǂ̏㑤̕
-                DxLib::DrawRotaGraph(
-                    pipeObject.mPositionX + this->mImagePipeWidth / 2,
-                    pipeObject.mTopPipeHeight - this->mImagePipeHeight / 2,
-                    1.0, ConvertDegreeToRadian<double>(180.0),
-                    this->mImageHandlePipe, FALSE, FALSE, FALSE);
-
-                // yǂ̉̕
-                DxLib::DrawGraph(
-                    pipeObject.mPositionX,
-                    CGame::WindowHeight - this->mImageGroundHeight - pipeObject.mBottomPipeHeight,
-                    this->mImageHandlePipe, FALSE);
+            for (EntityType entityType : { EntityType::Pipe, EntityType::MovingPipe }) {
+                const CEntityPool& entityPool = this->mEntities.GetPool(entityType);
+
+                for (std::size_t i = 0; i < entityPool.GetSize(); ++i) {
+                    if (!isVisible(entityPool, i))
+                        continue;
+
+                    int positionX = static_cast<int>(entityPool.mPositionX[i]);
+                    int gapTop = static_cast<int>(entityPool.mPositionY[i]);
+                    int gapBottom = static_cast<int>(entityPool.mPositionY[i] + entityPool.mHeight[i]);
+
+                    // yǂ̏㑤̕
+                    DxLib::DrawRotaGraph(
+                        positionX + this->mImagePipeWidth / 2,
+                        gapTop - this->mImagePipeHeight / 2,
+                        1.0, ConvertDegreeToRadian<double>(180.0),
+                        this->mImageHandlePipe, FALSE, FALSE, FALSE);
+
+                    // yǂ̉̕
+                    DxLib::DrawGraph(positionX, gapBottom, this->mImageHandlePipe, FALSE);
+                }
+            }
+
+            // ACe̕`
+            const CEntityPool& collectiblePool = this->mEntities.GetPool(EntityType::Collectible);
+            unsigned int collectibleColor = DxLib::GetColor(255, 215, 0);
+
+            for (std::size_t i = 0; i < collectiblePool.GetSize(); ++i) {
+                if ((collectiblePool.mFlags[i] & CEntityPool::FlagRemoved) != 0 ||
+                    !isVisible(collectiblePool, i))
+                    continue;
+
+                int radius = static_cast<int>(collectiblePool.mWidth[i] / 2.0f);
+                DxLib::DrawCircle(
+                    static_cast<int>(collectiblePool.mPositionX[i]) + radius,
+                    static_cast<int>(collectiblePool.mPositionY[i]) + radius,
+                    radius, collectibleColor, TRUE);
+            }
+
+            // Q̕`
+            const CEntityPool& hazardPool = this->mEntities.GetPool(EntityType::Hazard);
+            unsigned int hazardColor = DxLib::GetColor(128, 0, 128);
+
+            for (std::size_t i = 0; i < hazardPool.GetSize(); ++i) {
+                if (!isVisible(hazardPool, i))
+                    continue;
+
+                int left = static_cast<int>(hazardPool.mPositionX[i]);
+                int top = static_cast<int>(hazardPool.mPositionY[i]);
+                DxLib::DrawBox(
+                    left, top,
+                    left + static_cast<int>(hazardPool.mWidth[i]),
+                    top + static_cast<int>(hazardPool.mHeight[i]),
+                    hazardColor, TRUE);
             }
 
             // LN^[̕`
@@ -704,12 +2844,70 @@ void CGame::Draw()
             this->mImageBackgroundHeight,
             this->mImageHandleGround, FALSE);
     }
+
+    // ڑԂ̕`
+    this->DrawConnectionStatus();
+}
+
+void CGame::DrawConnectionStatus()
+{
+    // ڑԂɉ\Fƕ
+    unsigned int statusColor;
+    std::string statusText;
+
+    switch (this->mArduinoConnection->GetState()) {
+        case ArduinoConnectionState::Connected:
+        {
+            // |[g̐擪"\\.\"ĕ\
+            std::string portName = this->mArduinoConnection->GetPortName();
+            std::size_t prefixPosition = portName.find_last_of('\\');
+
+            if (prefixPosition != std::string::npos)
+                portName = portName.substr(prefixPosition + 1);
+
+            // {[hɓKpꂽݒ𕹂ĕ\
+            ArduinoDeviceConfig appliedConfig = this->mArduinoConnection->GetAppliedConfig();
+
+            if (appliedConfig.mBaudRate > 0)
+                portName += ", " + std::to_string(appliedConfig.mBaudRate) + "bps";
+
+            if (appliedConfig.mSamplingRate > 0)
+                portName += ", " + std::to_string(appliedConfig.mSamplingRate) + "Hz";
+
+            if (appliedConfig.mBatchSize > 0)
+                portName += ", x" + std::to_string(appliedConfig.mBatchSize);
+
+            statusColor = DxLib::GetColor(0, 255, 0);
+            statusText = "Connected (" + portName + ")";
+            break;
+        }
+
+        case ArduinoConnectionState::Reconnecting:
+        {
+            statusColor = DxLib::GetColor(255, 0, 0);
+            statusText = "Reconnecting...";
+            break;
+        }
+
+        case ArduinoConnectionState::Searching:
+        default:
+        {
+            statusColor = DxLib::GetColor(255, 255, 0);
+            statusText = "Searching...";
+            break;
+        }
+    }
+
+    // ʍɐڑԂ`
+    DxLib::DrawCircle(16, 16, 8, statusColor, TRUE);
+    DxLib::DrawString(
+        32, 8, static_cast<const TCHAR*>(statusText.c_str()), DxLib::GetColor(255, 255, 255));
 }
 
 int CGame::Run()
 {
-    // VA|[gڑ̏
-    this->InitializeArduinoInput();
+    // CxgŐL^̊Jn
+    CEventLog::GetInstance()->Start(CGame::EventLogDirectoryName);
 
     // DxCȕ
     DxLib::ChangeWindowMode(TRUE);
@@ -723,6 +2921,10 @@ int CGame::Run()
     if (DxLib::DxLib_Init() == -1)
         return -1;
 
+    // EBhE[hł͐̊Ԋu̓j^̃tbV[gŌ܂
+    int refreshRate = DxLib::GetRefreshRate();
+    this->mFramePacer.SetRefreshRate(refreshRate > 0 ? refreshRate : CGame::RefreshRate);
+
     // 摜̓ǂݍ
     this->LoadImages();
 
@@ -732,11 +2934,20 @@ int CGame::Run()
     // p[^̏
     this->InitializeParameters();
 
+    // VA|[gڑ̏
+    this->InitializeArduinoInput();
+
+    // ҋ@Ԃ̐x1[ms]ɐݒ
+    ::timeBeginPeriod(1);
+
     while (DxLib::ProcessMessage() == 0) {
+        // ̐ɊԂɍ͈͂, ͂̎擾ł邾x点
+        this->mFramePacer.WaitForLatch();
+
         DxLib::ClearDrawScreen();
         DxLib::SetDrawScreen(DX_SCREEN_BACK);
 
-        // ZT̓dl擾
+        // ZT̓dl擾 (M͕ʃXbhōs邽ߑҋ@Ȃ)
         this->HandleInput();
 
         // XV
@@ -745,15 +2956,22 @@ int CGame::Run()
         // `揈
         this->Draw();
 
+        this->mFramePacer.EndWork();
         DxLib::ScreenFlip();
+        this->mFramePacer.EndFrame();
     }
 
-    // DxCȕI
-    DxLib::DxLib_End();
+    ::timeEndPeriod(1);
 
     // VA|[gڑ̏I
     this->FinalizeArduinoInput();
 
+    // DxCȕI
+    DxLib::DxLib_End();
+
+    // CxgŐL^̏I
+    CEventLog::GetInstance()->Stop();
+
     return 0;
 }
 
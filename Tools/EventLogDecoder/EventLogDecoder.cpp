@@ -0,0 +1,319 @@
+
+/* ArduinoGame */
+/* Tools/EventLogDecoder/EventLogDecoder.cpp */
+
+//
+// Q[L^CxgO (EventLogs\EventLog_*.bin) eLXgɕϊc[
+// Q[͈̑傫ƂɃt@C؂ւ邽, NŋL^ꂽ̃t@C
+// ܂Ƃ߂Ďw肷1̋L^ƂĎɕׂďo͂ (L^JnقȂt@C͎włȂ)
+//
+// rh: g++ -std=c++14 -O2 -finput-charset=cp932 -I../../ArduinoGame -o EventLogDecoder EventLogDecoder.cpp
+//         (Visual Studiȍꍇ ArduinoGame fBNgCN[hpXɒǉ)
+//         \[Xt@C̓Q[{̂ƓShift-JIS (CP932) ŕۑĂ
+// s:   ./EventLogDecoder [--csv] <EventLog_*.bin>...
+//   --csv  1s1R[hCSV`ŏo͂ (Wv͏o͂Ȃ)
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "EventLogFormat.h"
+
+//
+// O̎擾
+// Ԃ̖OMain.cppGameState񋓑̂ArduinoConnectionState񋓑̂̏ɍ킹
+//
+static const char* GetEventTypeName(std::uint16_t eventType)
+{
+    switch (static_cast<EventType>(eventType)) {
+        case EventType::DroppedRecords: return "DroppedRecords";
+        case EventType::StateTransition: return "StateTransition";
+        case EventType::Score: return "Score";
+        case EventType::ParseFailure: return "ParseFailure";
+        case EventType::SerialError: return "SerialError";
+        case EventType::SerialIoError: return "SerialIoError";
+        case EventType::ConnectionState: return "ConnectionState";
+        case EventType::FrameTiming: return "FrameTiming";
+    }
+
+    return "Unknown";
+}
+
+static const char* GetGameStateName(std::int64_t gameState)
+{
+    static const char* GameStateNames[] = { "Start", "Play", "GameOver" };
+    return (gameState >= 0 && gameState < 3) ? GameStateNames[gameState] : "Unknown";
+}
+
+static const char* GetConnectionStateName(std::int64_t connectionState)
+{
+    static const char* ConnectionStateNames[] = { "Searching", "Connected", "Reconnecting" };
+    return (connectionState >= 0 && connectionState < 3) ?
+        ConnectionStateNames[connectionState] : "Unknown";
+}
+
+static const char* GetSerialOperationName(std::int64_t serialOperation)
+{
+    static const char* SerialOperationNames[] = {
+        "Open", "ClearCommError", "Read", "Write", "SetCommState" };
+    return (serialOperation >= 0 && serialOperation < 5) ?
+        SerialOperationNames[serialOperation] : "Unknown";
+}
+
+static std::string GetCommErrorFlags(std::uint32_t commError)
+{
+    // ClearCommErrorԂCE_*tO
+    static const struct { std::uint32_t mFlag; const char* mName; } CommErrorFlags[] = {
+        { 0x0001, "RXOVER" }, { 0x0002, "OVERRUN" }, { 0x0004, "RXPARITY" },
+        { 0x0008, "FRAME" }, { 0x0010, "BREAK" }, { 0x0100, "TXFULL" }
+    };
+
+    std::string flagNames;
+
+    for (const auto& commErrorFlag : CommErrorFlags) {
+        if ((commError & commErrorFlag.mFlag) == 0)
+            continue;
+
+        if (!flagNames.empty())
+            flagNames += "|";
+
+        flagNames += commErrorFlag.mName;
+    }
+
+    return flagNames.empty() ? "0" : flagNames;
+}
+
+static std::string GetPrintableLine(std::int64_t linePrefix, std::uint32_t lineLength)
+{
+    // ǂݍ߂Ȃs̐擪8oCg\\ȕɕϊ
+    char lineChars[sizeof(linePrefix)];
+    std::memcpy(lineChars, &linePrefix, sizeof(linePrefix));
+
+    std::string printableLine;
+    std::size_t numOfChars = std::min<std::size_t>(lineLength, sizeof(linePrefix));
+
+    for (std::size_t i = 0; i < numOfChars; ++i) {
+        unsigned char lineChar = static_cast<unsigned char>(lineChars[i]);
+
+        if (lineChar >= 0x20 && lineChar < 0x7F) {
+            printableLine += static_cast<char>(lineChar);
+        } else {
+            char escapedChar[8];
+            std::snprintf(escapedChar, sizeof(escapedChar), "\\x%02X", lineChar);
+            printableLine += escapedChar;
+        }
+    }
+
+    return printableLine;
+}
+
+//
+// 1R[h̓e̕ւ̕ϊ
+//
+static std::string DescribeRecord(const EventRecord& eventRecord)
+{
+    char description[256];
+
+    switch (static_cast<EventType>(eventRecord.mType)) {
+        case EventType::DroppedRecords:
+            std::snprintf(description, sizeof(description), "thread=%u dropped=%lld",
+                          eventRecord.mArg0, static_cast<long long>(eventRecord.mArg1));
+            break;
+
+        case EventType::StateTransition:
+            std::snprintf(description, sizeof(description), "%s -> %s score=%lld",
+                          GetGameStateName(eventRecord.mArg0), GetGameStateName(eventRecord.mArg1),
+                          static_cast<long long>(eventRecord.mArg2));
+            break;
+
+        case EventType::Score:
+            std::snprintf(description, sizeof(description), "%s +%lld score=%lld",
+                          eventRecord.mArg0 == static_cast<std::uint32_t>(ScoreReason::PipePassed) ?
+                          "PipePassed" : "Collectible",
+                          static_cast<long long>(eventRecord.mArg1),
+                          static_cast<long long>(eventRecord.mArg2));
+            break;
+
+        case EventType::ParseFailure:
+            std::snprintf(description, sizeof(description), "length=%u line=\"%s\" baud=%lld",
+                          eventRecord.mArg0,
+                          GetPrintableLine(eventRecord.mArg1, eventRecord.mArg0).c_str(),
+                          static_cast<long long>(eventRecord.mArg2));
+            break;
+
+        case EventType::SerialError:
+            std::snprintf(description, sizeof(description), "errors=%s queued=%lld",
+                          GetCommErrorFlags(eventRecord.mArg0).c_str(),
+                          static_cast<long long>(eventRecord.mArg1));
+            break;
+
+        case EventType::SerialIoError:
+            std::snprintf(description, sizeof(description), "operation=%s error=%u",
+                          GetSerialOperationName(eventRecord.mArg1), eventRecord.mArg0);
+            break;
+
+        case EventType::ConnectionState:
+            std::snprintf(description, sizeof(description), "%s port=COM%lld",
+                          GetConnectionStateName(eventRecord.mArg0),
+                          static_cast<long long>(eventRecord.mArg1));
+            break;
+
+        case EventType::FrameTiming:
+            std::snprintf(description, sizeof(description), "work=%.3fms interval=%.3fms%s",
+                          static_cast<double>(eventRecord.mArg1) / 1000000.0,
+                          static_cast<double>(eventRecord.mArg2) / 1000000.0,
+                          eventRecord.mArg0 != 0 ? " missed" : "");
+            break;
+
+        default:
+            std::snprintf(description, sizeof(description), "arg0=%u arg1=%lld arg2=%lld",
+                          eventRecord.mArg0, static_cast<long long>(eventRecord.mArg1),
+                          static_cast<long long>(eventRecord.mArg2));
+            break;
+    }
+
+    return description;
+}
+
+//
+// 1̃t@C̓ǂݍ
+//
+static bool ReadEventLog(
+    const char* fileName, EventLogHeader& eventLogHeader, std::vector<EventRecord>& eventRecords)
+{
+    std::FILE* pFile = std::fopen(fileName, "rb");
+
+    if (pFile == nullptr) {
+        std::perror(fileName);
+        return false;
+    }
+
+    // t@C̐擪̊mF
+    if (std::fread(&eventLogHeader, sizeof(EventLogHeader), 1, pFile) != 1 ||
+        std::memcmp(eventLogHeader.mMagic, EventLogMagic, sizeof(EventLogMagic)) != 0) {
+        std::fprintf(stderr, "%s: not an event log\n", fileName);
+        std::fclose(pFile);
+        return false;
+    }
+
+    if (eventLogHeader.mVersion != EventLogVersion ||
+        eventLogHeader.mRecordSize != sizeof(EventRecord)) {
+        std::fprintf(stderr, "%s: unsupported version %u (record size %u)\n",
+                     fileName, eventLogHeader.mVersion, eventLogHeader.mRecordSize);
+        std::fclose(pFile);
+        return false;
+    }
+
+    // SR[hǂݍ (̏̃R[h͖)
+    EventRecord eventRecord;
+
+    while (std::fread(&eventRecord, sizeof(EventRecord), 1, pFile) == 1)
+        eventRecords.push_back(eventRecord);
+
+    std::fclose(pFile);
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    bool isCsv = false;
+    std::vector<const char*> fileNames;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--csv") == 0)
+            isCsv = true;
+        else
+            fileNames.push_back(argv[i]);
+    }
+
+    if (fileNames.empty()) {
+        std::fprintf(stderr, "usage: %s [--csv] <EventLog_*.bin>...\n", argv[0]);
+        return 1;
+    }
+
+    // St@C̃R[h܂Ƃ߂ (NŋL^ꂽt@C͋L^Jn)
+    EventLogHeader eventLogHeader = EventLogHeader();
+    std::vector<EventRecord> eventRecords;
+
+    for (std::size_t i = 0; i < fileNames.size(); ++i) {
+        EventLogHeader fileHeader;
+
+        if (!ReadEventLog(fileNames[i], fileHeader, eventRecords))
+            return 1;
+
+        if (i == 0) {
+            eventLogHeader = fileHeader;
+        } else if (fileHeader.mStartTime != eventLogHeader.mStartTime) {
+            std::fprintf(stderr, "%s: recorded in a different session from %s\n",
+                         fileNames[i], fileNames[0]);
+            return 1;
+        }
+    }
+
+    // XbhƂɏoꂽɕבւ
+    std::stable_sort(eventRecords.begin(), eventRecords.end(),
+        [](const EventRecord& lhs, const EventRecord& rhs) {
+            return lhs.mTimestamp < rhs.mTimestamp;
+        });
+
+    if (isCsv) {
+        std::printf("time_ms,thread,type,arg0,arg1,arg2\n");
+
+        for (const auto& record : eventRecords)
+            std::printf("%.6f,%u,%s,%u,%lld,%lld\n",
+                        static_cast<double>(record.mTimestamp) / 1000000.0, record.mThreadIndex,
+                        GetEventTypeName(record.mType), record.mArg0,
+                        static_cast<long long>(record.mArg1), static_cast<long long>(record.mArg2));
+
+        return 0;
+    }
+
+    std::time_t startTime = static_cast<std::time_t>(eventLogHeader.mStartTime);
+    char startTimeText[64];
+    std::strftime(startTimeText, sizeof(startTimeText), "%Y-%m-%d %H:%M:%S", std::localtime(&startTime));
+    std::printf("# started at %s, %zu files, %zu records\n",
+                startTimeText, fileNames.size(), eventRecords.size());
+
+    // eR[h̏o͂, ނƂ̌ƃt[̎Ԃ̏Wv
+    std::size_t numOfRecords[16] = { };
+    std::vector<double> frameIntervals;
+    std::size_t numOfMissedFrames = 0;
+    double maxWorkTime = 0.0;
+
+    for (const auto& record : eventRecords) {
+        std::printf("%12.3f [%u] %-16s %s\n",
+                    static_cast<double>(record.mTimestamp) / 1000000.0, record.mThreadIndex,
+                    GetEventTypeName(record.mType), DescribeRecord(record).c_str());
+
+        numOfRecords[std::min<std::size_t>(record.mType, 15)]++;
+
+        if (static_cast<EventType>(record.mType) == EventType::FrameTiming) {
+            frameIntervals.push_back(static_cast<double>(record.mArg2) / 1000000.0);
+            maxWorkTime = std::max(maxWorkTime, static_cast<double>(record.mArg1) / 1000000.0);
+            numOfMissedFrames += record.mArg0 != 0 ? 1 : 0;
+        }
+    }
+
+    std::printf("# summary\n");
+
+    for (std::uint16_t i = 1; i < 16; ++i)
+        if (numOfRecords[i] > 0)
+            std::printf("#   %-16s %zu\n", GetEventTypeName(i), numOfRecords[i]);
+
+    if (!frameIntervals.empty()) {
+        std::sort(frameIntervals.begin(), frameIntervals.end());
+        std::printf("#   frame interval: median %.3fms, 99th %.3fms, max %.3fms, missed %zu\n",
+                    frameIntervals[frameIntervals.size() / 2],
+                    frameIntervals[frameIntervals.size() * 99 / 100],
+                    frameIntervals.back(), numOfMissedFrames);
+        std::printf("#   max work time: %.3fms\n", maxWorkTime);
+    }
+
+    return 0;
+}
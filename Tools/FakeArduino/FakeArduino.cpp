@@ -0,0 +1,459 @@
+
+/* ArduinoGame */
+/* Tools/FakeArduino/FakeArduino.cpp */
+
+//
+// 疑似端末(pty)上でArduinoマイコンボードの代わりに動作するテスト用プログラム
+// センサの出力値を送信し, ゲームからのコマンド(!PING, !RATE, !BATCH, !BAUD)に応答する
+//
+// ビルド: g++ -std=c++14 -O2 -o FakeArduino FakeArduino.cpp
+// 実行:   ./FakeArduino [--legacy] [--wrap]
+//   --legacy   コマンドに応答しない (起動直後の形式のみを送信する古いボード)
+//   --wrap     ボードの時刻を32ビットの循環の直前から開始する
+//
+// 起動すると接続先の端末名 (例: /dev/pts/3) を表示する
+// ゲームはWine上で実行し, WineのCOMポートを表示された端末に割り当てる
+//   ln -sf /dev/pts/3 ~/.wine/dosdevices/com3
+//   wine ArduinoGame.exe
+// ゲームは最初にCOM3への接続を試み, 応答がなければCOM1〜COM64を順に探索する
+// (他の番号に割り当てた場合も探索で見つかるが, COM3であれば接続までの時間が短い)
+// 端末側で設定されたボーレートとボードのボーレートが一致しない場合は,
+// 送受信されるデータが化けた状態を再現する
+//
+// 実機はポートを開くたびに (DTR信号により) リセットされるため, ゲーム側が端末を開いたことを
+// inotifyで検出してリセットを再現する (ボーレート, サンプリング周波数, 送信形式, ボードの時刻を初期化)
+// SIGUSR1を送信した場合も同様にリセットする
+//   kill -USR1 <FakeArduinoのプロセスID>
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <csignal>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+//
+// CFakeArduinoクラス
+//
+class CFakeArduino
+{
+public:
+    CFakeArduino(bool isLegacy, bool startNearWrap);
+    ~CFakeArduino();
+
+    bool Open();
+    int Run();
+
+    static void HandleResetSignal(int signalNumber);
+
+private:
+    void Reset();
+    void HandleOpenEvents();
+    std::uint32_t GetMicros() const;
+    int ReadSensorValue(std::uint32_t sampleTime) const;
+    bool IsBaudRateMatched() const;
+    void HandleReceivedData();
+    void HandleCommand(const std::string& line);
+    void SendLine(const std::string& line);
+    void SendSamples();
+
+private:
+    int mMasterFd;                      // 疑似端末のマスタ側
+    int mSlaveFd;                       // 疑似端末のスレーブ側 (切断を防ぐために保持)
+    int mNotifyFd;                      // スレーブ側が開かれたことの通知 (inotify)
+    bool mIsLegacy;                     // コマンドに応答しないかどうか
+    std::uint32_t mTimeOffset;          // ボードの時刻の初期値[us]
+    timespec mStartTime;                // 起動時刻
+
+    int mSamplingRate;                  // サンプリング周波数[Hz]
+    int mBatchSize;                     // 1回に送信する出力値の個数 (0の場合は起動直後の形式)
+    int mBaudRate;                      // ボードのボーレート[bps]
+    int mPreviousBaudRate;              // 変更前のボーレート[bps]
+    bool mBaudRatePending;              // ボーレートの変更の確認待ちかどうか
+    std::uint32_t mBaudRateChangedTime; // ボーレートを変更した時刻[us]
+
+    std::uint32_t mNextSampleTime;      // 次にセンサの値を読み取る時刻[us]
+    std::string mLineBuffer;            // 改行までの受信データ
+    std::string mBatchBuffer;           // 送信待ちの出力値
+    int mNumOfBatchedSamples;           // 送信待ちの出力値の個数
+    std::uint32_t mFirstBatchTime;      // 送信待ちの最初の出力値の時刻[us]
+
+    static const int DefaultBaudRate;       // 起動直後のボーレート[bps]
+    static const int DefaultSamplingRate;   // 起動直後のサンプリング周波数[Hz]
+    static const int MaxSamplingRate;       // サンプリング周波数の最大値[Hz]
+    static const int MaxBatchSize;          // 1回に送信する出力値の個数の最大値
+    static const std::uint32_t BaudRateRevertTime; // ボーレートを元に戻すまでの時間[us]
+
+    static volatile std::sig_atomic_t mResetRequested;  // SIGUSR1によるリセットの要求
+};
+
+volatile std::sig_atomic_t CFakeArduino::mResetRequested = 0;
+
+const int CFakeArduino::DefaultBaudRate = 57600;                // 起動直後のボーレート[bps]
+const int CFakeArduino::DefaultSamplingRate = 60;               // 起動直後のサンプリング周波数[Hz]
+const int CFakeArduino::MaxSamplingRate = 2000;                 // サンプリング周波数の最大値[Hz]
+const int CFakeArduino::MaxBatchSize = 32;                      // 1回に送信する出力値の個数の最大値
+const std::uint32_t CFakeArduino::BaudRateRevertTime = 2000000; // ボーレートを元に戻すまでの時間[us]
+
+CFakeArduino::CFakeArduino(bool isLegacy, bool startNearWrap) :
+    mMasterFd(-1),
+    mSlaveFd(-1),
+    mNotifyFd(-1),
+    mIsLegacy(isLegacy),
+    mTimeOffset(startNearWrap ? 0xFFFFFFFFu - 5000000u : 0u),
+    mStartTime(),
+    mSamplingRate(CFakeArduino::DefaultSamplingRate),
+    mBatchSize(0),
+    mBaudRate(CFakeArduino::DefaultBaudRate),
+    mPreviousBaudRate(CFakeArduino::DefaultBaudRate),
+    mBaudRatePending(false),
+    mBaudRateChangedTime(0),
+    mNextSampleTime(0),
+    mLineBuffer(),
+    mBatchBuffer(),
+    mNumOfBatchedSamples(0),
+    mFirstBatchTime(0)
+{
+    ::clock_gettime(CLOCK_MONOTONIC, &this->mStartTime);
+}
+
+CFakeArduino::~CFakeArduino()
+{
+    if (this->mNotifyFd >= 0)
+        ::close(this->mNotifyFd);
+
+    if (this->mSlaveFd >= 0)
+        ::close(this->mSlaveFd);
+
+    if (this->mMasterFd >= 0)
+        ::close(this->mMasterFd);
+}
+
+bool CFakeArduino::Open()
+{
+    // 疑似端末の作成
+    this->mMasterFd = ::posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (this->mMasterFd < 0 || ::grantpt(this->mMasterFd) != 0 || ::unlockpt(this->mMasterFd) != 0) {
+        std::perror("posix_openpt");
+        return false;
+    }
+
+    const char* pSlaveName = ::ptsname(this->mMasterFd);
+
+    // ゲーム側が接続していない間も切断されないようにスレーブ側を開いておく
+    this->mSlaveFd = ::open(pSlaveName, O_RDWR | O_NOCTTY);
+
+    if (this->mSlaveFd < 0) {
+        std::perror("open");
+        return false;
+    }
+
+    // 改行コードの変換やエコーを無効にし, 起動直後のボーレートを設定
+    termios ttyAttributes;
+    ::tcgetattr(this->mSlaveFd, &ttyAttributes);
+    ::cfmakeraw(&ttyAttributes);
+    ::cfsetispeed(&ttyAttributes, B57600);
+    ::cfsetospeed(&ttyAttributes, B57600);
+    ::tcsetattr(this->mSlaveFd, TCSANOW, &ttyAttributes);
+
+    // ゲーム側がスレーブ側を開いたことを検出する (自身が開いた後に登録する)
+    this->mNotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (this->mNotifyFd < 0 || ::inotify_add_watch(this->mNotifyFd, pSlaveName, IN_OPEN) < 0) {
+        std::perror("inotify");
+        return false;
+    }
+
+    std::printf("%s\n", pSlaveName);
+    std::fflush(stdout);
+
+    return true;
+}
+
+int CFakeArduino::Run()
+{
+    char receiveBuffer[256];
+
+    this->mNextSampleTime = this->GetMicros();
+
+    for (;;) {
+        // 次にセンサの値を読み取る時刻まで受信を待つ
+        // (1[ms]未満の残り時間を切り捨てると待機せずに繰り返すため切り上げる)
+        std::uint32_t currentTime = this->GetMicros();
+        std::int32_t waitTime = static_cast<std::int32_t>(this->mNextSampleTime - currentTime);
+
+        pollfd pollFds[2] = { { this->mMasterFd, POLLIN, 0 }, { this->mNotifyFd, POLLIN, 0 } };
+        int pollResult = ::poll(pollFds, 2, std::max(0, (waitTime + 999) / 1000));
+
+        if (pollResult < 0 && errno != EINTR) {
+            std::perror("poll");
+            return 1;
+        }
+
+        // ポートが開かれた場合やSIGUSR1を受信した場合はリセット
+        if (pollResult > 0 && (pollFds[1].revents & POLLIN))
+            this->HandleOpenEvents();
+
+        if (CFakeArduino::mResetRequested != 0) {
+            CFakeArduino::mResetRequested = 0;
+            this->Reset();
+        }
+
+        if (pollResult > 0 && (pollFds[0].revents & POLLIN)) {
+            ssize_t bytesRead = ::read(this->mMasterFd, receiveBuffer, sizeof(receiveBuffer));
+
+            if (bytesRead > 0 && this->IsBaudRateMatched())
+                this->mLineBuffer.append(receiveBuffer, static_cast<std::size_t>(bytesRead));
+
+            this->HandleReceivedData();
+        }
+
+        // PINGを受信できないまま一定時間が経過したらボーレートを元に戻す
+        currentTime = this->GetMicros();
+
+        if (this->mBaudRatePending &&
+            currentTime - this->mBaudRateChangedTime > CFakeArduino::BaudRateRevertTime) {
+            std::fprintf(stderr, "baud rate reverted to %d\n", this->mPreviousBaudRate);
+            this->mBaudRate = this->mPreviousBaudRate;
+            this->mBaudRatePending = false;
+        }
+
+        if (static_cast<std::int32_t>(currentTime - this->mNextSampleTime) >= 0)
+            this->SendSamples();
+    }
+}
+
+void CFakeArduino::HandleResetSignal(int signalNumber)
+{
+    (void)signalNumber;
+    CFakeArduino::mResetRequested = 1;
+}
+
+void CFakeArduino::Reset()
+{
+    // 起動直後の状態に戻す (ボードの時刻も初期値から数え直す)
+    std::fprintf(stderr, "reset\n");
+
+    ::clock_gettime(CLOCK_MONOTONIC, &this->mStartTime);
+    this->mSamplingRate = CFakeArduino::DefaultSamplingRate;
+    this->mBatchSize = 0;
+    this->mBaudRate = CFakeArduino::DefaultBaudRate;
+    this->mPreviousBaudRate = CFakeArduino::DefaultBaudRate;
+    this->mBaudRatePending = false;
+    this->mBaudRateChangedTime = 0;
+    this->mNextSampleTime = this->GetMicros();
+    this->mLineBuffer.clear();
+    this->mBatchBuffer.clear();
+    this->mNumOfBatchedSamples = 0;
+    this->mFirstBatchTime = 0;
+}
+
+void CFakeArduino::HandleOpenEvents()
+{
+    // 通知を読み捨て, 1回以上開かれていればリセット
+    alignas(inotify_event) char eventBuffer[4096];
+    bool isOpened = false;
+    ssize_t bytesRead;
+
+    while ((bytesRead = ::read(this->mNotifyFd, eventBuffer, sizeof(eventBuffer))) > 0)
+        isOpened = true;
+
+    if (isOpened)
+        this->Reset();
+}
+
+std::uint32_t CFakeArduino::GetMicros() const
+{
+    // Arduinoのmicros()と同様に32ビットで循環する時刻
+    timespec currentTime;
+    ::clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+    long long elapsedTime =
+        static_cast<long long>(currentTime.tv_sec - this->mStartTime.tv_sec) * 1000000LL +
+        (currentTime.tv_nsec - this->mStartTime.tv_nsec) / 1000;
+
+    return this->mTimeOffset + static_cast<std::uint32_t>(elapsedTime);
+}
+
+int CFakeArduino::ReadSensorValue(std::uint32_t sampleTime) const
+{
+    // 手をかざして上下させた場合を想定した周期3秒の正弦波
+    double elapsedTime = static_cast<double>(sampleTime - this->mTimeOffset) / 1000000.0;
+    return 500 + static_cast<int>(350.0 * std::sin(2.0 * 3.141592653589793 * elapsedTime / 3.0));
+}
+
+bool CFakeArduino::IsBaudRateMatched() const
+{
+    // 端末側で設定されたボーレートの取得
+    termios ttyAttributes;
+
+    if (::tcgetattr(this->mSlaveFd, &ttyAttributes) != 0)
+        return true;
+
+    static const struct { speed_t mSpeed; int mBaudRate; } BaudRates[] = {
+        { B9600, 9600 }, { B19200, 19200 }, { B38400, 38400 }, { B57600, 57600 },
+        { B115200, 115200 }, { B230400, 230400 }, { B500000, 500000 }, { B1000000, 1000000 }
+    };
+
+    speed_t speed = ::cfgetospeed(&ttyAttributes);
+
+    for (const auto& baudRate : BaudRates)
+        if (baudRate.mSpeed == speed)
+            return baudRate.mBaudRate == this->mBaudRate;
+
+    return false;
+}
+
+void CFakeArduino::HandleReceivedData()
+{
+    std::size_t lineEnd;
+
+    while ((lineEnd = this->mLineBuffer.find('\n')) != std::string::npos) {
+        std::string line = this->mLineBuffer.substr(0, lineEnd);
+        this->mLineBuffer.erase(0, lineEnd + 1);
+
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        if (!this->mIsLegacy && !line.empty() && line[0] == '!')
+            this->HandleCommand(line);
+    }
+}
+
+void CFakeArduino::HandleCommand(const std::string& line)
+{
+    char commandName[16];
+    int commandValue = 0;
+    int numOfFields = std::sscanf(line.c_str(), "!%15s %d", commandName, &commandValue);
+
+    if (numOfFields < 1)
+        return;
+
+    std::string name = commandName;
+    std::fprintf(stderr, "command: %s\n", line.c_str());
+
+    if (name == "PING") {
+        // 新しいボーレートでPINGを受信したら変更を確定
+        this->mBaudRatePending = false;
+        this->SendLine("#ACK PING");
+    } else if (name == "RATE" && numOfFields == 2 &&
+               commandValue >= 1 && commandValue <= CFakeArduino::MaxSamplingRate) {
+        this->mSamplingRate = commandValue;
+        this->mBatchBuffer.clear();
+        this->mNumOfBatchedSamples = 0;
+        this->SendLine("#ACK RATE " + std::to_string(commandValue));
+    } else if (name == "BATCH" && numOfFields == 2 &&
+               commandValue >= 1 && commandValue <= CFakeArduino::MaxBatchSize) {
+        this->mBatchSize = commandValue;
+        this->mBatchBuffer.clear();
+        this->mNumOfBatchedSamples = 0;
+        this->SendLine("#ACK BATCH " + std::to_string(commandValue));
+    } else if (name == "BAUD" && numOfFields == 2 &&
+               (commandValue == 9600 || commandValue == 19200 || commandValue == 38400 ||
+                commandValue == 57600 || commandValue == 115200 || commandValue == 230400 ||
+                commandValue == 500000 || commandValue == 1000000)) {
+        // 元のボーレートでACKを送信し終えてから切り替える
+        this->SendLine("#ACK BAUD " + std::to_string(commandValue));
+        ::tcdrain(this->mMasterFd);
+
+        this->mPreviousBaudRate = this->mBaudRate;
+        this->mBaudRate = commandValue;
+        this->mBaudRatePending = true;
+        this->mBaudRateChangedTime = this->GetMicros();
+    } else {
+        this->SendLine("#NAK " + name);
+    }
+}
+
+void CFakeArduino::SendLine(const std::string& line)
+{
+    std::string data = line + "\r\n";
+
+    // ボーレートが一致しない場合はデータが化ける
+    if (!this->IsBaudRateMatched())
+        for (auto& dataChar : data)
+            dataChar = static_cast<char>(std::rand() & 0xFF);
+
+    // ゲーム側が読み込まずに溢れた分は捨てる (実機と同様)
+    int fileFlags = ::fcntl(this->mMasterFd, F_GETFL);
+    ::fcntl(this->mMasterFd, F_SETFL, fileFlags | O_NONBLOCK);
+    ssize_t bytesWritten = ::write(this->mMasterFd, data.data(), data.size());
+    ::fcntl(this->mMasterFd, F_SETFL, fileFlags);
+
+    (void)bytesWritten;
+}
+
+void CFakeArduino::SendSamples()
+{
+    std::uint32_t sampleTime = this->mNextSampleTime;
+    std::uint32_t samplingInterval = 1000000u / static_cast<std::uint32_t>(this->mSamplingRate);
+    int sensorValue = this->ReadSensorValue(sampleTime);
+
+    this->mNextSampleTime += samplingInterval;
+
+    // 大きく遅れた場合は現在時刻から計測をやり直す
+    if (static_cast<std::int32_t>(this->GetMicros() - this->mNextSampleTime) > 100000)
+        this->mNextSampleTime = this->GetMicros();
+
+    if (this->mBatchSize == 0) {
+        // 起動直後の形式 (2つ目の値は使用されない)
+        this->SendLine(std::to_string(sensorValue) + "," + std::to_string(sensorValue / 4));
+        return;
+    }
+
+    // 一定個数の出力値をまとめて計測時刻とともに送信
+    if (this->mNumOfBatchedSamples == 0)
+        this->mFirstBatchTime = sampleTime;
+
+    this->mBatchBuffer += "," + std::to_string(sensorValue);
+    ++this->mNumOfBatchedSamples;
+
+    if (this->mNumOfBatchedSamples < this->mBatchSize)
+        return;
+
+    this->SendLine(
+        "@" + std::to_string(this->mNumOfBatchedSamples) + "," +
+        std::to_string(this->mFirstBatchTime) + "," +
+        std::to_string(samplingInterval) + this->mBatchBuffer);
+
+    this->mBatchBuffer.clear();
+    this->mNumOfBatchedSamples = 0;
+}
+
+int main(int argc, char** argv)
+{
+    bool isLegacy = false;
+    bool startNearWrap = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--legacy") == 0) {
+            isLegacy = true;
+        } else if (std::strcmp(argv[i], "--wrap") == 0) {
+            startNearWrap = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--legacy] [--wrap]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    CFakeArduino fakeArduino(isLegacy, startNearWrap);
+    std::signal(SIGUSR1, &CFakeArduino::HandleResetSignal);
+
+    if (!fakeArduino.Open())
+        return 1;
+
+    return fakeArduino.Run();
+}